@@ -3,6 +3,7 @@
 * Implements Astar algorithm for pathfinding. Used with Graph and Grid classes.
 */
 #include "AStar.h"
+#include <algorithm>
 #include <iostream>
 
 // Constructor for Astar object
@@ -14,35 +15,63 @@ void AStar::findPath(const Position &aStartPosition, const Position &anEndPositi
 	startPosition = aStartPosition;
 	endPosition = anEndPosition;
 
+	// An end position walled off from the start position is rejected without searching
+	if (!aGrid.isReachable(startPosition, endPosition)) {
+		endPositionFound = false;
+		return;
+	}
+
 	// Instantiate the wall flag for each wall
 	for (const auto& wall : theWalls) {
 		graph.getVertex(wall).isWall = true;
 	}
 
-	// Small function for comparing totalDistance (startToVertex + vertexToEnd distances) between two vertices, determines cheaper route
-	auto totalDistanceComparison = [](graphVertex *leftVertex, graphVertex *rightVertex) // Auto used as this is for sorting, not boolean
-	{
-		return leftVertex->totalDistance < rightVertex->totalDistance;
-	};
+	search(&aGrid, &aWindow);
+}
+
+// Method that calculates path using Astar algorithm given start and end position, using walls already set within the graph and drawing nothing
+void AStar::findPath(const Position &aStartPosition, const Position &anEndPosition) {
+	// Define start and end positions of this instance
+	startPosition = aStartPosition;
+	endPosition = anEndPosition;
+
+	search(nullptr, nullptr);
+}
+
+// Helper function for findPath that runs the search, drawing progress to the grid and window when they are given
+void AStar::search(Grid *aGrid, sf::RenderWindow *aWindow) {
+	// Clear state left over from any previous search; the graph clears each vertex lazily as the search reaches it
+	priorityQueue = decltype(priorityQueue)();
+	graph.resetGraph();
+	endPositionFound = false;
 
 	// Define starting and ending squares as vertices
 	graphVertex* startingVertex = &(graph.getVertex(startPosition));
 	startingVertex->startToVertexDistance = 0; // This is starting vertex to startToVertexDistance is 0
 	graphVertex* endingVertex = &(graph.getVertex(endPosition));
 	startingVertex->vertexToEndDistance = vertexDistance(startingVertex, endingVertex); // Define distance from start to end
+	startingVertex->totalDistance = startingVertex->vertexToEndDistance;
 
 	// Start Astar algorithm by pushing startingVertex to the priority queue
-	priorityQueue.emplace_back(startingVertex);
+	priorityQueue.emplace(startingVertex->totalDistance, startingVertex);
 
 	// Iterate while priority queue is not empty, indicating potential vertices to process, or until endPosition is found
 	while (!priorityQueue.empty() && !endPositionFound) {
-		priorityQueue.sort(totalDistanceComparison); // Sort vertices within priority queue by their total distance
+		// Copy cheapest vertex from priority queue, then pop it
+		graphVertex *currentVertex = priorityQueue.top().second;
+		double queuedDistance = priorityQueue.top().first;
+		priorityQueue.pop();
 
-		// Copy cheapest vertex from priority queue, then pop it and color it accordingly in aGrid
-		graphVertex *currentVertex = priorityQueue.front();
-		priorityQueue.pop_front();
+		// Skip vertices already processed or queued entries made outdated by a cheaper route
+		if (currentVertex->processedVertex || queuedDistance > currentVertex->totalDistance) {
+			continue;
+		}
+
+		// Mark the vertex processed and color it accordingly in aGrid
 		currentVertex->processedVertex = true;
-		aGrid.colorProcessedSquare(currentVertex->vertexPosition);
+		if (aGrid != nullptr) {
+			aGrid->colorProcessedSquare(currentVertex->vertexPosition);
+		}
 
 		// Check if currentVertex is at endPosition
 		if (currentVertex->vertexPosition == endPosition) {
@@ -50,11 +79,15 @@ void AStar::findPath(const Position &aStartPosition, const Position &anEndPositi
 		}
 		
 		// Update grid representation
-		aGrid.drawGrid();
-		aWindow.display();
+		if (aGrid != nullptr && aWindow != nullptr) {
+			aGrid->drawGrid();
+			aWindow->display();
+		}
 
 		// Iterate through neighboring vertices
 		for (auto& neighbor : currentVertex->neighboringVertices) {
+			graph.refreshVertex(neighbor);
+
 			// If neighbor is already processed or a wall, skip iteration
 			if (neighbor->processedVertex || neighbor->isWall) {
 				continue;
@@ -70,17 +103,12 @@ void AStar::findPath(const Position &aStartPosition, const Position &anEndPositi
 					neighbor->startToVertexDistance = approxStartToVertexDistance;
 					neighbor->vertexToEndDistance = vertexDistance(neighbor, endingVertex); // Using Euclidean distance calculation
 					neighbor->totalDistance = neighbor->startToVertexDistance + neighbor->vertexToEndDistance;
-					
-					// Find neighbor in neighboringVertices of currentVertex
-					auto find = neighboringVertices.find(neighbor);
-
-					// Verify that neighbor is within neighboringVertices of currentVertex
-					if (find == neighboringVertices.end()) {
-						// Indicate this neighbor is being processed in grid representation and add it to priority queue and neighboringVertices
-						aGrid.colorProcessingSquare(neighbor->vertexPosition);
-						priorityQueue.emplace_back(neighbor);
-						neighboringVertices.insert(neighbor);
+
+					// Indicate this neighbor is being processed in grid representation and add it to priority queue
+					if (aGrid != nullptr) {
+						aGrid->colorProcessingSquare(neighbor->vertexPosition);
 					}
+					priorityQueue.emplace(neighbor->totalDistance, neighbor);
 				}
 			}
 		}
@@ -103,6 +131,21 @@ void AStar::loadPath(Grid &aGrid) {
 	}
 }
 
+// Accessor method for the squares of the computed path, ordered from start to end (empty if no path exists)
+std::vector<Position> AStar::getPath() {
+	std::vector<Position> path;
+	if (!endPositionFound) {
+		return path;
+	}
+
+	// Walk parents back from endPosition, then reverse into start to end order
+	for (graphVertex *traversingVertex = &graph.getVertex(endPosition); traversingVertex != nullptr; traversingVertex = traversingVertex->parent) {
+		path.push_back(traversingVertex->vertexPosition);
+	}
+	std::reverse(path.begin(), path.end());
+	return path;
+}
+
 // Method that calculates Euclidean distance between two vertices
 double AStar::vertexDistance(graphVertex *leftVertex, graphVertex *rightVertex) {
 	// Calculate differentials
@@ -0,0 +1,234 @@
+/*
+* Implementation file for the AnytimeAStar class.
+* Implements Anytime Repairing A* (ARA*) over the packed walls of a map.
+*/
+#include "AnytimeAStar.h"
+#include "GridMoves.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+	// The deadline is checked once per this many expansions, keeping clock reads off the hot path
+	const int expansionsPerDeadlineCheck = 256;
+
+	// Longest weight schedule built from an initial weight; larger weights are lowered in bigger steps instead
+	const int maxScheduleLength = 16;
+}
+
+// Constructor for AnytimeAStar object, given the walls of the map to search
+AnytimeAStar::AnytimeAStar(const WallBitset &aWallBitset) : wallBitset(aWallBitset) {
+	xTiles = std::get<0>(wallBitset.getNumberOfSquares());
+	yTiles = std::get<1>(wallBitset.getNumberOfSquares());
+	vertices.resize(static_cast<size_t>(xTiles) * yTiles);
+}
+
+// Method that searches from start to end until the deadline, using each heuristic weight of the schedule in turn
+// The first search inflates the heuristic by the first weight and finds a path quickly. Every later search lowers the
+// weight and continues from the vertices left open by the previous one (plus those improved after being expanded),
+// instead of starting over. A path found with weight w is at most w times longer than the shortest path.
+AnytimeResult AnytimeAStar::findPath(const Position &aStartPosition, const Position &anEndPosition, std::chrono::steady_clock::time_point aDeadline, const std::vector<double> &aWeightSchedule) {
+	AnytimeResult result;
+
+	// Both endpoints must be free squares of the map
+	if (!wallBitset.inBounds(aStartPosition) || !wallBitset.inBounds(anEndPosition) || wallBitset.isWall(aStartPosition) || wallBitset.isWall(anEndPosition)) {
+		return result;
+	}
+
+	// Starting a new query makes every vertex unvisited without touching them
+	queryCount++;
+	expansionCount = 0;
+
+	// Once the counter wraps, stamps from long ago would look current again, so clear every vertex for real
+	if (queryCount == 0) {
+		for (auto &vertex : vertices) {
+			vertex.visitedQuery = 0;
+		}
+		queryCount = 1;
+	}
+	openHeap.clear();
+	inconsistentVertices.clear();
+
+	int startIndex = aStartPosition.xPosition * yTiles + aStartPosition.yPosition;
+	int endIndex = anEndPosition.xPosition * yTiles + anEndPosition.yPosition;
+	searchVertex &startingVertex = getVertex(startIndex);
+	startingVertex.startToVertexDistance = 0;
+	startingVertex.open = true;
+	openHeap.emplace_back(0.0, startIndex);
+
+	// Without a schedule, run a single optimal search
+	std::vector<double> weightSchedule = aWeightSchedule.empty() ? std::vector<double>{ 1.0 } : aWeightSchedule;
+
+	for (size_t searchIndex = 0; searchIndex < weightSchedule.size(); searchIndex++) {
+		// Out of time before the next search begins; reordering the heap alone may take a while on large maps
+		if (std::chrono::steady_clock::now() >= aDeadline) {
+			result.timedOut = result.completedSearches == 0;
+			break;
+		}
+
+		double weight = std::max(1.0, weightSchedule[searchIndex]);
+		searchCount++;
+
+		// Likewise for the search counter, which expanded vertices are stamped with
+		if (searchCount == 0) {
+			for (auto &vertex : vertices) {
+				vertex.closedSearch = 0;
+			}
+			searchCount = 1;
+		}
+
+		// Reorder the open vertices and the inconsistent vertices of the previous search by their new weighted distance
+		std::vector<heapEntry> previousHeap;
+		previousHeap.swap(openHeap);
+		for (const auto &entry : previousHeap) {
+			searchVertex &vertex = getVertex(entry.second);
+			if (vertex.open) {
+				vertex.open = false; // Cleared so duplicate entries are only taken once, restored below
+				openHeap.emplace_back(vertex.startToVertexDistance + weight * heuristic(entry.second, endIndex), entry.second);
+			}
+		}
+		for (int vertexIndex : inconsistentVertices) {
+			searchVertex &vertex = getVertex(vertexIndex);
+			vertex.inconsistent = false;
+			if (vertex.open) {
+				continue;
+			}
+			openHeap.emplace_back(vertex.startToVertexDistance + weight * heuristic(vertexIndex, endIndex), vertexIndex);
+		}
+		inconsistentVertices.clear();
+		for (const auto &entry : openHeap) {
+			getVertex(entry.second).open = true;
+		}
+		std::make_heap(openHeap.begin(), openHeap.end(), std::greater<heapEntry>());
+
+		// Out of time: the best path so far stands, and without one the end was neither reached nor ruled out
+		if (!improvePath(endIndex, weight, aDeadline)) {
+			result.timedOut = result.completedSearches == 0;
+			break;
+		}
+
+		// Every reachable vertex was expanded without reaching the end, so no path exists
+		searchVertex &endingVertex = getVertex(endIndex);
+		if (endingVertex.startToVertexDistance == INFINITY) {
+			break;
+		}
+		result.completedSearches++;
+
+		// Keep the new path if it is shorter
+		if (endingVertex.startToVertexDistance < result.pathCost) {
+			result.pathCost = endingVertex.startToVertexDistance;
+			result.path.clear();
+			for (int vertexIndex = endIndex; vertexIndex != -1; vertexIndex = getVertex(vertexIndex).parent) {
+				result.path.push_back({ vertexIndex / yTiles, vertexIndex % yTiles });
+			}
+			std::reverse(result.path.begin(), result.path.end());
+		}
+
+		// The shortest path is no shorter than the lowest unweighted estimate among vertices still waiting to be expanded
+		double lowestEstimate = result.pathCost;
+		for (const auto &entry : openHeap) {
+			const searchVertex &vertex = getVertex(entry.second);
+			if (vertex.open) {
+				lowestEstimate = std::min(lowestEstimate, vertex.startToVertexDistance + heuristic(entry.second, endIndex));
+			}
+		}
+		for (int vertexIndex : inconsistentVertices) {
+			lowestEstimate = std::min(lowestEstimate, getVertex(vertexIndex).startToVertexDistance + heuristic(vertexIndex, endIndex));
+		}
+		result.suboptimalityBound = lowestEstimate > 0 ? std::min(weight, result.pathCost / lowestEstimate) : 1.0;
+
+		// Stop once the path is proven shortest
+		if (result.suboptimalityBound <= 1.0) {
+			result.suboptimalityBound = 1.0;
+			break;
+		}
+	}
+	return result;
+}
+
+// Method that searches from start to end for at most the given time, lowering the weight from the given value in steps of 0.5
+// Initial weights above 9 are lowered in maxScheduleLength equal steps instead, so a huge weight cannot queue millions of searches
+AnytimeResult AnytimeAStar::findPath(const Position &aStartPosition, const Position &anEndPosition, std::chrono::microseconds aBudget, double anInitialWeight) {
+	std::vector<double> weightSchedule;
+	double weightStep = std::max(0.5, (anInitialWeight - 1.0) / maxScheduleLength);
+	for (double weight = anInitialWeight; weight > 1.0 && static_cast<int>(weightSchedule.size()) < maxScheduleLength; weight -= weightStep) {
+		weightSchedule.push_back(weight);
+	}
+	weightSchedule.push_back(1.0);
+	return findPath(aStartPosition, anEndPosition, std::chrono::steady_clock::now() + aBudget, weightSchedule);
+}
+
+// Helper function that expands vertices until the end cannot be reached more cheaply, returning false if the deadline passes
+bool AnytimeAStar::improvePath(int anEndIndex, double aWeight, std::chrono::steady_clock::time_point aDeadline) {
+	while (!openHeap.empty() && openHeap.front().first < getVertex(anEndIndex).startToVertexDistance) {
+		// Copy cheapest vertex from the heap, then pop it
+		heapEntry cheapest = openHeap.front();
+		std::pop_heap(openHeap.begin(), openHeap.end(), std::greater<heapEntry>());
+		openHeap.pop_back();
+
+		// Skip entries made outdated by a cheaper route
+		searchVertex &currentVertex = getVertex(cheapest.second);
+		if (!currentVertex.open || cheapest.first != currentVertex.startToVertexDistance + aWeight * heuristic(cheapest.second, anEndIndex)) {
+			continue;
+		}
+		currentVertex.open = false;
+		currentVertex.closedSearch = searchCount;
+
+		// The first expansion of a query reads the clock too, so short searches cannot outlast the deadline unnoticed
+		if (expansionCount++ % expansionsPerDeadlineCheck == 0 && std::chrono::steady_clock::now() >= aDeadline) {
+			return false;
+		}
+
+		// Iterate through neighboring squares
+		int x = cheapest.second / yTiles;
+		int y = cheapest.second % yTiles;
+		for (int n = 0; n < GridMoves::moveCount; n++) {
+			Position neighborPosition = { x + GridMoves::moveX[n], y + GridMoves::moveY[n] };
+			if (!wallBitset.inBounds(neighborPosition) || wallBitset.isWall(neighborPosition)) {
+				continue;
+			}
+
+			int neighborIndex = neighborPosition.xPosition * yTiles + neighborPosition.yPosition;
+			searchVertex &neighbor = getVertex(neighborIndex);
+			double approxStartToVertexDistance = currentVertex.startToVertexDistance + GridMoves::moveWeight(n);
+
+			// This condition indicates a more optimal path exists from the start to the neighbor
+			if (approxStartToVertexDistance < neighbor.startToVertexDistance) {
+				neighbor.startToVertexDistance = approxStartToVertexDistance;
+				neighbor.parent = cheapest.second;
+
+				// Vertices already expanded in this search wait for the next one
+				if (neighbor.closedSearch == searchCount) {
+					if (!neighbor.inconsistent) {
+						neighbor.inconsistent = true;
+						inconsistentVertices.push_back(neighborIndex);
+					}
+				}
+				else {
+					neighbor.open = true;
+					openHeap.emplace_back(approxStartToVertexDistance + aWeight * heuristic(neighborIndex, anEndIndex), neighborIndex);
+					std::push_heap(openHeap.begin(), openHeap.end(), std::greater<heapEntry>());
+				}
+			}
+		}
+	}
+	return true;
+}
+
+// Helper function that returns the search state of a square, clearing state left over from an earlier query
+AnytimeAStar::searchVertex &AnytimeAStar::getVertex(int anIndex) {
+	searchVertex &vertex = vertices[anIndex];
+	if (vertex.visitedQuery != queryCount) {
+		vertex.startToVertexDistance = INFINITY;
+		vertex.parent = -1;
+		vertex.closedSearch = 0;
+		vertex.open = false;
+		vertex.inconsistent = false;
+		vertex.visitedQuery = queryCount;
+	}
+	return vertex;
+}
+
+// Helper function that estimates the distance between two squares, never overestimating it
+double AnytimeAStar::heuristic(int anIndex, int anotherIndex) const {
+	return GridMoves::octileDistance(anIndex, anotherIndex, yTiles);
+}
@@ -0,0 +1,85 @@
+/*
+* Header file for the AnytimeAStar class.
+* Implementation of Anytime Repairing A* (ARA*): a weighted A* path is found quickly, then improved until a deadline.
+*/
+#pragma once
+#include "Position.h"
+#include "WallBitset.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Defines an AnytimeResult struct, the best path found by AnytimeAStar before its deadline
+struct AnytimeResult {
+	// Squares of the best path, ordered from start to end (empty if no path was found in time)
+	std::vector<Position> path;
+
+	// Length of the best path, INFINITY if none was found
+	double pathCost = INFINITY;
+
+	// The best path is at most this many times longer than the shortest path (1 when it is the shortest)
+	double suboptimalityBound = INFINITY;
+
+	// Number of searches completed, each with a smaller heuristic weight than the last
+	int completedSearches = 0;
+
+	// Flag indicating the deadline passed before the first search completed, so a path may exist although none was found
+	bool timedOut = false;
+};
+
+class AnytimeAStar {
+public:
+	// Constructor for AnytimeAStar object, given the walls of the map to search
+	AnytimeAStar(const WallBitset &);
+
+	// Method that searches from start to end until the deadline, using each heuristic weight of the schedule in turn
+	// Each search reuses the effort of the previous one, and the search stops early once the path is proven shortest
+	AnytimeResult findPath(const Position &, const Position &, std::chrono::steady_clock::time_point, const std::vector<double> &);
+
+	// Method that searches from start to end for at most the given time, lowering the weight from the given value in steps of 0.5
+	// (in larger equal steps above 9, so at most 16 weights come before the final weight of 1)
+	AnytimeResult findPath(const Position &, const Position &, std::chrono::microseconds, double = 3.0);
+
+private:
+	// Defines a searchVertex struct, the search state kept for every square
+	struct searchVertex {
+		double startToVertexDistance;
+		int parent;
+		std::uint32_t visitedQuery = 0;		// Query in which the state above was last written; older state counts as unvisited
+		std::uint32_t closedSearch = 0;		// Search in which the vertex was last expanded
+		bool open;							// Vertex may be within the heap
+		bool inconsistent;					// Vertex was improved after being expanded, so it is kept for the next search
+	};
+
+	// Walls of the map being searched
+	const WallBitset &wallBitset;
+
+	// Number of squares horizontally and vertically
+	int xTiles;
+	int yTiles;
+
+	// Search state of every square, indexed by x * yTiles + y, and the counters that make resetting it unnecessary
+	std::vector<searchVertex> vertices;
+	std::uint32_t queryCount = 0;
+	std::uint32_t searchCount = 0;
+
+	// Expansions made during the current query, counted across searches so the deadline is read at a steady rate
+	int expansionCount = 0;
+
+	// Binary heap of (weighted total distance, square) pairs, cheapest first; outdated entries are skipped when popped
+	typedef std::pair<double, int> heapEntry;
+	std::vector<heapEntry> openHeap;
+
+	// Squares improved after being expanded during the current search
+	std::vector<int> inconsistentVertices;
+
+	// Helper function that expands vertices until the end cannot be reached more cheaply, returning false if the deadline passes
+	bool improvePath(int, double, std::chrono::steady_clock::time_point);
+
+	// Helper function that returns the search state of a square, clearing state left over from an earlier query
+	searchVertex &getVertex(int);
+
+	// Helper function that estimates the distance between two squares, never overestimating it
+	double heuristic(int, int) const;
+};
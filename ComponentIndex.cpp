@@ -0,0 +1,349 @@
+/*
+* Implementation file for the ComponentIndex class, a labeling of the connected regions of free squares within a map.
+* Implementation of all public and private methods.
+*/
+#include "ComponentIndex.h"
+#include "GridMoves.h"
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+	// Labels are never reused, so once there are this many per square the forest is rebuilt to reclaim them
+	const int componentsPerSquareLimit = 2;
+}
+
+// Constructor for ComponentIndex object, given the walls of a map and the number of threads used for labeling
+ComponentIndex::ComponentIndex(const WallBitset &aWallBitset, int aThreadCount) : wallBitset(aWallBitset), threadCount{ aThreadCount } {
+	xTiles = std::get<0>(wallBitset.getNumberOfSquares());
+	yTiles = std::get<1>(wallBitset.getNumberOfSquares());
+
+	// Default to one thread per core
+	if (threadCount <= 0) {
+		threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+	rebuild();
+}
+
+// Method that labels every square from scratch, each thread labeling a strip of columns before the strips are joined
+// Each strip is a union-find over its own squares, so threads never touch the same square. The strips are then joined
+// along their shared edges, and every square is labeled with the root of its tree. Union by size keeps trees shallow.
+void ComponentIndex::rebuild() {
+	const int squareCount = xTiles * yTiles;
+	std::vector<int> squareParents(squareCount);
+	std::vector<int> squareSizes(squareCount);
+	labels.assign(squareCount, -1);
+
+	auto findSquare = [&](int aSquare) {
+		while (squareParents[aSquare] != aSquare) {
+			squareParents[aSquare] = squareParents[squareParents[aSquare]]; // Path halving
+			aSquare = squareParents[aSquare];
+		}
+		return aSquare;
+	};
+	auto unionSquares = [&](int aSquare, int anotherSquare) {
+		int aRoot = findSquare(aSquare);
+		int anotherRoot = findSquare(anotherSquare);
+		if (aRoot == anotherRoot) {
+			return;
+		}
+		if (squareSizes[aRoot] < squareSizes[anotherRoot]) {
+			std::swap(aRoot, anotherRoot);
+		}
+		squareParents[anotherRoot] = aRoot;
+		squareSizes[aRoot] += squareSizes[anotherRoot];
+	};
+	auto isFree = [&](int x, int y) {
+		return y >= 0 && y < yTiles && !wallBitset.isWall({ x, y });
+	};
+
+	// Split the columns into one strip per thread
+	int stripCount = std::max(1, std::min(threadCount, xTiles));
+	std::vector<int> stripStarts(stripCount + 1);
+	for (int s = 0; s <= stripCount; s++) {
+		stripStarts[s] = static_cast<int>(static_cast<long long>(xTiles) * s / stripCount);
+	}
+
+	// Label each strip, joining every free square to its free neighbors earlier in the strip
+	auto labelStrip = [&](int aStrip) {
+		for (int x = stripStarts[aStrip]; x < stripStarts[aStrip + 1]; x++) {
+			for (int y = 0; y < yTiles; y++) {
+				if (!isFree(x, y)) {
+					continue;
+				}
+				int square = x * yTiles + y;
+				squareParents[square] = square;
+				squareSizes[square] = 1;
+
+				if (isFree(x, y - 1)) {
+					unionSquares(square, square - 1);
+				}
+				if (x > stripStarts[aStrip]) {
+					for (int dy = -1; dy <= 1; dy++) {
+						if (isFree(x - 1, y + dy)) {
+							unionSquares(square, square - yTiles + dy);
+						}
+					}
+				}
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int s = 1; s < stripCount; s++) {
+		threads.emplace_back(labelStrip, s);
+	}
+	labelStrip(0);
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	// Join neighboring strips along their shared edge
+	for (int s = 1; s < stripCount; s++) {
+		int x = stripStarts[s];
+		for (int y = 0; y < yTiles; y++) {
+			if (!isFree(x, y)) {
+				continue;
+			}
+			for (int dy = -1; dy <= 1; dy++) {
+				if (isFree(x - 1, y + dy)) {
+					unionSquares(x * yTiles + y, (x - 1) * yTiles + y + dy);
+				}
+			}
+		}
+	}
+
+	// Label every square with its root, each thread reading (never compressing) the trees of its own strip
+	auto flattenStrip = [&](int aStrip) {
+		for (int square = stripStarts[aStrip] * yTiles; square < stripStarts[aStrip + 1] * yTiles; square++) {
+			if (!isFree(square / yTiles, square % yTiles)) {
+				continue;
+			}
+			int root = square;
+			while (squareParents[root] != root) {
+				root = squareParents[root];
+			}
+			labels[square] = root;
+		}
+	};
+	threads.clear();
+	for (int s = 1; s < stripCount; s++) {
+		threads.emplace_back(flattenStrip, s);
+	}
+	flattenStrip(0);
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	// Every root square becomes its own component label
+	componentParents.resize(squareCount);
+	for (int i = 0; i < squareCount; i++) {
+		componentParents[i] = i;
+	}
+	componentRanks.assign(squareCount, 0);
+	visitedStamps.assign(squareCount, 0);
+	visitedOwners.assign(squareCount, 0);
+	visitStamp = 0;
+}
+
+// Method that updates the labels after the square at given position was turned into a wall or freed within the bitset
+void ComponentIndex::updateSquare(const Position &aPosition) {
+	// Validate position
+	if (!wallBitset.inBounds(aPosition)) {
+		return;
+	}
+
+	int square = aPosition.xPosition * yTiles + aPosition.yPosition;
+	bool isWall = wallBitset.isWall(aPosition);
+	if (isWall && labels[square] != -1) {
+		blockSquare(square);
+	}
+	else if (!isWall && labels[square] == -1) {
+		freeSquare(square);
+	}
+
+	// Splits and freed squares keep adding labels; relabeling from scratch drops the stale ones. At least one label per
+	// square was added since the last rebuild, so the cost of rebuilding is spread over as many updates
+	if (componentParents.size() > static_cast<size_t>(componentsPerSquareLimit) * xTiles * yTiles) {
+		rebuild();
+	}
+}
+
+// Method that determines whether two squares are free and connected, making a path between them possible
+bool ComponentIndex::connected(const Position &aPosition, const Position &anotherPosition) const {
+	if (!wallBitset.inBounds(aPosition) || !wallBitset.inBounds(anotherPosition)) {
+		return false;
+	}
+
+	int aLabel = labels[aPosition.xPosition * yTiles + aPosition.yPosition];
+	int anotherLabel = labels[anotherPosition.xPosition * yTiles + anotherPosition.yPosition];
+	return aLabel != -1 && anotherLabel != -1 && findComponent(aLabel) == findComponent(anotherLabel);
+}
+
+// Helper function that labels a square freed from being a wall, merging the components around it
+void ComponentIndex::freeSquare(int aSquare) {
+	std::vector<int> neighbors;
+	freeNeighbors(aSquare, neighbors);
+
+	// Join the components of all free neighbors, or start a new component if the square is isolated
+	int label = -1;
+	for (int neighbor : neighbors) {
+		label = label == -1 ? findComponent(labels[neighbor]) : unionComponents(label, labels[neighbor]);
+	}
+	labels[aSquare] = label == -1 ? newComponent() : label;
+}
+
+// Helper function that labels a square turned into a wall, giving fresh labels to any regions it cut off
+// The free neighbors of the square are first grouped by which ones touch each other directly. If there are several
+// groups, a breadth-first search is run from each group in turn, one square at a time. Searches that meet are merged.
+// A search that runs out of squares has found a region now cut off from the rest. Once a single search is left, it
+// keeps the old label, so only the squares of the smaller, cut off regions are visited and relabeled.
+void ComponentIndex::blockSquare(int aSquare) {
+	labels[aSquare] = -1;
+	std::vector<int> neighbors;
+	freeNeighbors(aSquare, neighbors);
+	if (neighbors.size() <= 1) {
+		return;
+	}
+
+	// Group neighbors that touch each other, as those stay connected without the square
+	int neighborCount = static_cast<int>(neighbors.size());
+	std::vector<int> groupParents(neighborCount);
+	auto findGroup = [&](int aGroup) {
+		while (groupParents[aGroup] != aGroup) {
+			aGroup = groupParents[aGroup];
+		}
+		return aGroup;
+	};
+	for (int i = 0; i < neighborCount; i++) {
+		groupParents[i] = i;
+	}
+	for (int i = 0; i < neighborCount; i++) {
+		for (int j = i + 1; j < neighborCount; j++) {
+			int dx = std::abs(neighbors[i] / yTiles - neighbors[j] / yTiles);
+			int dy = std::abs(neighbors[i] % yTiles - neighbors[j] % yTiles);
+			if (dx <= 1 && dy <= 1) {
+				groupParents[findGroup(j)] = findGroup(i);
+			}
+		}
+	}
+
+	// A single group means the new wall cannot have split anything
+	int activeCount = 0;
+	for (int i = 0; i < neighborCount; i++) {
+		activeCount += groupParents[i] == i ? 1 : 0;
+	}
+	if (activeCount <= 1) {
+		return;
+	}
+
+	// Seed one search per group, each search keeping the squares it visited and a queue of squares still to expand
+	visitStamp++;
+	std::vector<std::vector<int>> regions(neighborCount);
+	std::vector<std::vector<int>> queues(neighborCount);
+	std::vector<size_t> queueHeads(neighborCount, 0);
+	std::vector<bool> exhausted(neighborCount, false);
+	for (int i = 0; i < neighborCount; i++) {
+		int group = findGroup(i);
+		visitedStamps[neighbors[i]] = visitStamp;
+		visitedOwners[neighbors[i]] = static_cast<std::uint8_t>(group);
+		regions[group].push_back(neighbors[i]);
+		queues[group].push_back(neighbors[i]);
+	}
+
+	// Advance each search in turn until one search is left
+	std::vector<int> nextSquares;
+	while (activeCount > 1) {
+		for (int group = 0; group < neighborCount && activeCount > 1; group++) {
+			if (groupParents[group] != group || exhausted[group]) {
+				continue;
+			}
+
+			// A search that runs out of squares has found a cut off region
+			if (queueHeads[group] == queues[group].size()) {
+				exhausted[group] = true;
+				activeCount--;
+				continue;
+			}
+
+			int currentSquare = queues[group][queueHeads[group]++];
+			freeNeighbors(currentSquare, nextSquares);
+			for (int nextSquare : nextSquares) {
+				if (visitedStamps[nextSquare] != visitStamp) {
+					visitedStamps[nextSquare] = visitStamp;
+					visitedOwners[nextSquare] = static_cast<std::uint8_t>(group);
+					regions[group].push_back(nextSquare);
+					queues[group].push_back(nextSquare);
+					continue;
+				}
+
+				// Meeting another search means both regions are still connected, so this search takes over the other
+				int otherGroup = findGroup(visitedOwners[nextSquare]);
+				if (otherGroup != group) {
+					groupParents[otherGroup] = group;
+					regions[group].insert(regions[group].end(), regions[otherGroup].begin(), regions[otherGroup].end());
+					queues[group].insert(queues[group].end(), queues[otherGroup].begin() + queueHeads[otherGroup], queues[otherGroup].end());
+					activeCount--;
+				}
+			}
+		}
+	}
+
+	// The search still running keeps the old label; every cut off region gets a fresh one
+	for (int group = 0; group < neighborCount; group++) {
+		if (groupParents[group] != group || !exhausted[group]) {
+			continue;
+		}
+		int label = newComponent();
+		for (int square : regions[group]) {
+			labels[square] = label;
+		}
+	}
+}
+
+// Helper function that returns the root of a component label without modifying the forest
+int ComponentIndex::findComponent(int aComponent) const {
+	while (componentParents[aComponent] != aComponent) {
+		aComponent = componentParents[aComponent];
+	}
+	return aComponent;
+}
+
+// Helper function that joins two components, returning the root of the result
+int ComponentIndex::unionComponents(int aComponent, int anotherComponent) {
+	int aRoot = findComponent(aComponent);
+	int anotherRoot = findComponent(anotherComponent);
+	if (aRoot == anotherRoot) {
+		return aRoot;
+	}
+
+	// Union by rank keeps every tree logarithmically shallow
+	if (componentRanks[aRoot] < componentRanks[anotherRoot]) {
+		std::swap(aRoot, anotherRoot);
+	}
+	componentParents[anotherRoot] = aRoot;
+	if (componentRanks[aRoot] == componentRanks[anotherRoot]) {
+		componentRanks[aRoot]++;
+	}
+	return aRoot;
+}
+
+// Helper function that creates a new component label, returning it
+int ComponentIndex::newComponent() {
+	int component = static_cast<int>(componentParents.size());
+	componentParents.push_back(component);
+	componentRanks.push_back(0);
+	return component;
+}
+
+// Helper function that fills given vector with the indices of the free neighbors of a square
+void ComponentIndex::freeNeighbors(int aSquare, std::vector<int> &someNeighbors) const {
+	someNeighbors.clear();
+	int x = aSquare / yTiles;
+	int y = aSquare % yTiles;
+	for (int n = 0; n < GridMoves::moveCount; n++) {
+		Position neighborPosition = { x + GridMoves::moveX[n], y + GridMoves::moveY[n] };
+		if (wallBitset.inBounds(neighborPosition) && !wallBitset.isWall(neighborPosition)) {
+			someNeighbors.push_back(neighborPosition.xPosition * yTiles + neighborPosition.yPosition);
+		}
+	}
+}
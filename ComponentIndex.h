@@ -0,0 +1,65 @@
+/*
+* Header file for the ComponentIndex class, a labeling of the connected regions of free squares within a map.
+* Lets queries between squares in different regions be rejected without searching.
+*/
+#pragma once
+#include "Position.h"
+#include "WallBitset.h"
+#include <cstdint>
+#include <vector>
+
+class ComponentIndex {
+public:
+	// Constructor for ComponentIndex object, given the walls of a map and the number of threads used for labeling (0 for one per core)
+	ComponentIndex(const WallBitset &, int = 0);
+
+	// Method that labels every square from scratch, each thread labeling a strip of columns before the strips are joined
+	void rebuild();
+
+	// Method that updates the labels after the square at given position was turned into a wall or freed within the bitset
+	void updateSquare(const Position &);
+
+	// Method that determines whether two squares are free and connected, making a path between them possible
+	bool connected(const Position &, const Position &) const;
+
+private:
+	// Walls of the map being labeled
+	const WallBitset &wallBitset;
+
+	// Number of squares horizontally and vertically
+	int xTiles;
+	int yTiles;
+
+	// Number of threads used by rebuild
+	int threadCount;
+
+	// Component label of each square, indexed by x * yTiles + y, -1 for walls
+	std::vector<int> labels;
+
+	// Union-find forest over component labels, so freeing a wall can merge components without relabeling squares
+	std::vector<int> componentParents;
+	std::vector<std::uint8_t> componentRanks;
+
+	// Visited marks used when adding a wall, reset by bumping the stamp
+	std::vector<std::uint32_t> visitedStamps;
+	std::vector<std::uint8_t> visitedOwners;
+	std::uint32_t visitStamp = 0;
+
+	// Helper function that labels a square freed from being a wall, merging the components around it
+	void freeSquare(int);
+
+	// Helper function that labels a square turned into a wall, giving fresh labels to any regions it cut off
+	void blockSquare(int);
+
+	// Helper function that returns the root of a component label without modifying the forest
+	int findComponent(int) const;
+
+	// Helper function that joins two components, returning the root of the result
+	int unionComponents(int, int);
+
+	// Helper function that creates a new component label, returning it
+	int newComponent();
+
+	// Helper function that fills given vector with the indices of the free neighbors of a square
+	void freeNeighbors(int, std::vector<int> &) const;
+};
@@ -0,0 +1,171 @@
+/*
+* Implementation file for the Connection classes, byte streams used by PathServer and PathClient.
+* Implementation of all methods for both Windows (Winsock AF_UNIX) and POSIX systems.
+*/
+#include "Connection.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	// Helper function that fills a Unix domain socket address, returning false if the path does not fit
+	bool makeAddress(const std::string &aPath, sockaddr_un &anAddress) {
+		std::memset(&anAddress, 0, sizeof(anAddress));
+		anAddress.sun_family = AF_UNIX;
+		if (aPath.size() >= sizeof(anAddress.sun_path)) {
+			return false;
+		}
+		std::memcpy(anAddress.sun_path, aPath.c_str(), aPath.size() + 1);
+		return true;
+	}
+
+	// Helper function that initializes Winsock once per process (nothing is needed on POSIX systems)
+	bool initializeSockets() {
+#ifdef _WIN32
+		static bool initialized = false;
+		if (!initialized) {
+			WSADATA data;
+			initialized = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+		}
+		return initialized;
+#else
+		return true;
+#endif
+	}
+}
+
+// Constructor for StreamConnection object, given input and output file descriptors
+StreamConnection::StreamConnection(int anInputDescriptor, int anOutputDescriptor) : inputDescriptor{ anInputDescriptor }, outputDescriptor{ anOutputDescriptor } {
+#ifdef _WIN32
+	// Frames are binary, so newline translation must be disabled
+	_setmode(inputDescriptor, _O_BINARY);
+	_setmode(outputDescriptor, _O_BINARY);
+#endif
+}
+
+// Method that reads up to the given number of bytes from the input descriptor
+int StreamConnection::receive(char *aBuffer, int aSize) {
+#ifdef _WIN32
+	return _read(inputDescriptor, aBuffer, aSize);
+#else
+	return static_cast<int>(read(inputDescriptor, aBuffer, aSize));
+#endif
+}
+
+// Method that writes every given byte to the output descriptor
+bool StreamConnection::send(const char *aBuffer, int aSize) {
+	while (aSize > 0) {
+#ifdef _WIN32
+		int written = _write(outputDescriptor, aBuffer, aSize);
+#else
+		int written = static_cast<int>(write(outputDescriptor, aBuffer, aSize));
+#endif
+		if (written <= 0) {
+			return false;
+		}
+		aBuffer += written;
+		aSize -= written;
+	}
+	return true;
+}
+
+// Constructor for SocketConnection object, taking ownership of a connected socket
+SocketConnection::SocketConnection(socketHandle aSocket) : socket{ aSocket } {}
+
+// Destructor for SocketConnection object, closes the socket
+SocketConnection::~SocketConnection() {
+	closeSocket(socket);
+}
+
+// Method that reads up to the given number of bytes from the socket
+int SocketConnection::receive(char *aBuffer, int aSize) {
+	return static_cast<int>(recv(socket, aBuffer, aSize, 0));
+}
+
+// Method that writes every given byte to the socket
+bool SocketConnection::send(const char *aBuffer, int aSize) {
+	// A client disconnecting mid-write must not terminate the server
+#ifdef MSG_NOSIGNAL
+	const int flags = MSG_NOSIGNAL;
+#else
+	const int flags = 0;
+#endif
+	while (aSize > 0) {
+		int written = static_cast<int>(::send(socket, aBuffer, aSize, flags));
+		if (written <= 0) {
+			return false;
+		}
+		aBuffer += written;
+		aSize -= written;
+	}
+	return true;
+}
+
+// Method that creates a Unix domain socket listening at the given path, replacing any stale socket file
+socketHandle SocketConnection::listenAt(const std::string &aPath) {
+	sockaddr_un address;
+	if (!initializeSockets() || !makeAddress(aPath, address)) {
+		return invalidSocket;
+	}
+
+	socketHandle listener = static_cast<socketHandle>(::socket(AF_UNIX, SOCK_STREAM, 0));
+	if (listener == invalidSocket) {
+		return invalidSocket;
+	}
+
+	// A socket file left behind by a previous server would make bind fail
+#ifdef _WIN32
+	_unlink(aPath.c_str());
+#else
+	unlink(aPath.c_str());
+#endif
+	if (bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listener, 4) != 0) {
+		closeSocket(listener);
+		return invalidSocket;
+	}
+	return listener;
+}
+
+// Method that blocks until a client connects to a listening socket
+socketHandle SocketConnection::acceptFrom(socketHandle aListener) {
+	return static_cast<socketHandle>(accept(aListener, nullptr, nullptr));
+}
+
+// Method that connects to a Unix domain socket listening at the given path
+socketHandle SocketConnection::connectTo(const std::string &aPath) {
+	sockaddr_un address;
+	if (!initializeSockets() || !makeAddress(aPath, address)) {
+		return invalidSocket;
+	}
+
+	socketHandle client = static_cast<socketHandle>(::socket(AF_UNIX, SOCK_STREAM, 0));
+	if (client == invalidSocket) {
+		return invalidSocket;
+	}
+	if (connect(client, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+		closeSocket(client);
+		return invalidSocket;
+	}
+	return client;
+}
+
+// Method that closes a socket handle
+void SocketConnection::closeSocket(socketHandle aSocket) {
+	if (aSocket == invalidSocket) {
+		return;
+	}
+#ifdef _WIN32
+	closesocket(aSocket);
+#else
+	close(aSocket);
+#endif
+}
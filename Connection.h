@@ -0,0 +1,80 @@
+/*
+* Header file for the Connection classes, byte streams used by PathServer and PathClient.
+* A connection is either a pair of standard streams or a Unix domain socket.
+*/
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Platform type of a socket handle
+#ifdef _WIN32
+typedef std::uintptr_t socketHandle;
+#else
+typedef int socketHandle;
+#endif
+
+// Value returned in place of a socket handle when a socket operation fails
+const socketHandle invalidSocket = static_cast<socketHandle>(-1);
+
+class Connection {
+public:
+	virtual ~Connection() {}
+
+	// Method that reads up to the given number of bytes, blocking until at least one arrives; returns 0 at end of stream and negative on error
+	virtual int receive(char *, int) = 0;
+
+	// Method that writes every given byte, returning false on error
+	virtual bool send(const char *, int) = 0;
+};
+
+class StreamConnection : public Connection {
+public:
+	// Constructor for StreamConnection object, given input and output file descriptors (standard input and output in binary mode by default)
+	StreamConnection(int = 0, int = 1);
+
+	// Method that reads up to the given number of bytes from the input descriptor
+	int receive(char *, int) override;
+
+	// Method that writes every given byte to the output descriptor
+	bool send(const char *, int) override;
+
+private:
+	// File descriptors of the input and output streams
+	int inputDescriptor;
+	int outputDescriptor;
+};
+
+class SocketConnection : public Connection {
+public:
+	// Constructor for SocketConnection object, taking ownership of a connected socket
+	SocketConnection(socketHandle);
+
+	// Destructor for SocketConnection object, closes the socket
+	~SocketConnection();
+
+	// Method that reads up to the given number of bytes from the socket
+	int receive(char *, int) override;
+
+	// Method that writes every given byte to the socket
+	bool send(const char *, int) override;
+
+	// Method that creates a Unix domain socket listening at the given path, replacing any stale socket file
+	static socketHandle listenAt(const std::string &);
+
+	// Method that blocks until a client connects to a listening socket
+	static socketHandle acceptFrom(socketHandle);
+
+	// Method that connects to a Unix domain socket listening at the given path
+	static socketHandle connectTo(const std::string &);
+
+	// Method that closes a socket handle
+	static void closeSocket(socketHandle);
+
+private:
+	// Connected socket owned by this connection
+	socketHandle socket;
+
+	// Connections cannot be copied, as each owns its socket
+	SocketConnection(const SocketConnection &) = delete;
+	SocketConnection &operator=(const SocketConnection &) = delete;
+};
@@ -0,0 +1,235 @@
+/*
+* Implementation file for the CooperativeAStar class.
+* Implements Windowed Cooperative A* over the packed walls of a map and a shared reservation table.
+*/
+#include "CooperativeAStar.h"
+#include "GridMoves.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+
+namespace {
+	// Waiting for a time step costs as much as a straight move
+	const double waitWeight = GridMoves::straightWeight;
+}
+
+// Constructor for CooperativeAStar object, given the walls of the map, the number of time steps planned per window,
+// and the number of agents expected per window
+CooperativeAStar::CooperativeAStar(const WallBitset &aWallBitset, int aWindowLength, int anExpectedAgents)
+	: wallBitset(aWallBitset), windowLength{ aWindowLength }, reservationTable(aWindowLength, anExpectedAgents) {
+	xTiles = std::get<0>(wallBitset.getNumberOfSquares());
+	yTiles = std::get<1>(wallBitset.getNumberOfSquares());
+	slotNodes.resize(4096);
+	slotStamps.resize(4096, 0);
+}
+
+// Method that plans the next window for every agent, in order of priority, returning the plan of each agent.
+// Agents follow the first steps of their plans and are then replanned
+// Before planning, every agent reserves its start square for the whole window, as if it waited there. Each agent then
+// trades that reservation for its planned path, so agents never route through agents planned after them, and waiting
+// in place remains open to every agent. No two plans share a square at a time step, swap places, or cross diagonally
+// through the same corner, except for agents that start on a wall, outside the map, or on the square of another agent;
+// those are reported as not planned.
+// Only the window is ever reserved, so memory stays proportional to the window length and number of agents however far
+// the agents travel.
+std::vector<CooperativePlan> CooperativeAStar::planWindow(const std::vector<CooperativeAgent> &anAgents) {
+	std::vector<CooperativePlan> plans(anAgents.size());
+	std::vector<int> startSquares(anAgents.size(), -1);
+	std::vector<int> squares;
+
+	// Every agent is replanned, so reservations from the previous window no longer hold
+	reservationTable.clear();
+
+	// Hold the start square of every agent for the whole window
+	for (std::size_t agent = 0; agent < anAgents.size(); agent++) {
+		const Position &startPosition = anAgents[agent].startPosition;
+		if (!wallBitset.inBounds(startPosition) || wallBitset.isWall(startPosition)) {
+			continue;
+		}
+		int startSquare = startPosition.xPosition * yTiles + startPosition.yPosition;
+		if (!reservationTable.reserve(0, startSquare, -1)) {
+			continue; // Another agent already stands on this square
+		}
+		for (int time = 1; time <= windowLength; time++) {
+			reservationTable.reserve(time, startSquare, startSquare);
+		}
+		startSquares[agent] = startSquare;
+	}
+
+	for (std::size_t agent = 0; agent < anAgents.size(); agent++) {
+		// Agents without a square of their own wait where they are, reserving nothing
+		if (startSquares[agent] == -1) {
+			plans[agent].path.assign(windowLength + 1, anAgents[agent].startPosition);
+			continue;
+		}
+
+		// Give up the held start square, then plan; waiting there is always possible, as no other agent reserved it
+		for (int time = 0; time <= windowLength; time++) {
+			reservationTable.release(time, startSquares[agent]);
+		}
+		bool planned = planAgent(anAgents[agent], squares);
+		if (!planned) {
+			squares.assign(windowLength + 1, startSquares[agent]);
+		}
+
+		// Reserve the planned squares so lower priority agents route around them
+		for (int time = 0; time <= windowLength; time++) {
+			if (!reservationTable.reserve(time, squares[time], time == 0 ? -1 : squares[time - 1])) {
+				planned = false;
+			}
+			plans[agent].path.push_back({ squares[time] / yTiles, squares[time] % yTiles });
+		}
+		plans[agent].planned = planned;
+	}
+	return plans;
+}
+
+// Helper function that searches the window for one agent against the reservation table, filling given vector with its
+// square at each time step; returns false if every route is blocked
+// The search ends at the first node popped at the last time step of the window. Since the octile distance to the end
+// is added to every node, that node minimizes the time spent within the window plus the estimated distance beyond it,
+// which lets agents make progress toward destinations further than one window away. Waiting at the end costs nothing,
+// so agents that arrive early stay there.
+bool CooperativeAStar::planAgent(const CooperativeAgent &anAgent, std::vector<int> &aSquares) {
+	// Both endpoints must be free squares of the map
+	if (!wallBitset.inBounds(anAgent.startPosition) || !wallBitset.inBounds(anAgent.endPosition) || wallBitset.isWall(anAgent.startPosition) || wallBitset.isWall(anAgent.endPosition)) {
+		return false;
+	}
+
+	int startIndex = anAgent.startPosition.xPosition * yTiles + anAgent.startPosition.yPosition;
+	int endIndex = anAgent.endPosition.xPosition * yTiles + anAgent.endPosition.yPosition;
+
+	// Starting a new search makes every slot of the node table empty without touching it
+	searchStamp++;
+
+	// Once the stamp wraps, never written slots (stamp 0) would look current, so clear the table for real
+	if (searchStamp == 0) {
+		std::fill(slotStamps.begin(), slotStamps.end(), 0);
+		searchStamp = 1;
+	}
+	nodes.clear();
+	openHeap.clear();
+
+	int startNode = getNode(startIndex, 0);
+	nodes[startNode].startToNodeDistance = 0;
+	openHeap.emplace_back(heuristic(startIndex, endIndex), startNode);
+
+	while (!openHeap.empty()) {
+		std::pop_heap(openHeap.begin(), openHeap.end(), std::greater<heapEntry>());
+		int currentNode = openHeap.back().second;
+		openHeap.pop_back();
+		if (nodes[currentNode].closed) {
+			continue;
+		}
+		nodes[currentNode].closed = true;
+
+		int currentSquare = nodes[currentNode].square;
+		int currentTime = nodes[currentNode].time;
+		double currentDistance = nodes[currentNode].startToNodeDistance;
+
+		// Reached the end of the window: walk back through the parents to recover the square at each time step
+		if (currentTime == windowLength) {
+			aSquares.assign(windowLength + 1, -1);
+			for (int node = currentNode; node != -1; node = nodes[node].parent) {
+				aSquares[nodes[node].time] = nodes[node].square;
+			}
+			return true;
+		}
+
+		// Iterate through waiting in place (n == -1) and moving to each neighboring square
+		int x = currentSquare / yTiles;
+		int y = currentSquare % yTiles;
+		for (int n = -1; n < GridMoves::moveCount; n++) {
+			Position nextPosition = { x, y };
+			double weight = currentSquare == endIndex ? 0.0 : waitWeight;
+			if (n >= 0) {
+				nextPosition = { x + GridMoves::moveX[n], y + GridMoves::moveY[n] };
+				if (!wallBitset.inBounds(nextPosition) || wallBitset.isWall(nextPosition)) {
+					continue;
+				}
+				weight = GridMoves::moveWeight(n);
+			}
+			int nextSquare = nextPosition.xPosition * yTiles + nextPosition.yPosition;
+
+			// Skip squares another agent occupies at the next time step, and moves that swap places with another agent
+			if (reservationTable.isReserved(currentTime + 1, nextSquare)) {
+				continue;
+			}
+			if (n >= 0 && reservationTable.isMove(currentTime + 1, nextSquare, currentSquare)) {
+				continue;
+			}
+
+			// Skip diagonal moves crossing another agent's diagonal move between the two squares beside them
+			if (n >= 0 && GridMoves::isDiagonal(n)) {
+				int besideX = nextPosition.xPosition * yTiles + y;
+				int besideY = x * yTiles + nextPosition.yPosition;
+				if (reservationTable.isMove(currentTime + 1, besideX, besideY) || reservationTable.isMove(currentTime + 1, besideY, besideX)) {
+					continue;
+				}
+			}
+
+			// Creating the node may move the node vector, so it is accessed through its index
+			int nextNode = getNode(nextSquare, currentTime + 1);
+			double distance = currentDistance + weight;
+
+			// This condition indicates a more optimal path exists from the start to the next node
+			if (distance < nodes[nextNode].startToNodeDistance) {
+				nodes[nextNode].startToNodeDistance = distance;
+				nodes[nextNode].parent = currentNode;
+				openHeap.emplace_back(distance + heuristic(nextSquare, endIndex), nextNode);
+				std::push_heap(openHeap.begin(), openHeap.end(), std::greater<heapEntry>());
+			}
+		}
+	}
+	return false;
+}
+
+// Helper function that returns the node of a square at a time step, creating it if the current search has not yet
+int CooperativeAStar::getNode(int aSquare, int aTime) {
+	int slot = findSlot(aSquare, aTime);
+	if (slotStamps[slot] == searchStamp) {
+		return slotNodes[slot];
+	}
+
+	// Keep the node table at most half full so probes stay short
+	if ((nodes.size() + 1) * 2 > slotNodes.size()) {
+		growNodeTable();
+		slot = findSlot(aSquare, aTime);
+	}
+	nodes.push_back({ aSquare, aTime, INFINITY, -1, false });
+	slotNodes[slot] = static_cast<int>(nodes.size() - 1);
+	slotStamps[slot] = searchStamp;
+	return slotNodes[slot];
+}
+
+// Helper function that returns the slot of the node table holding a square at a time step, or the empty slot where it would go
+int CooperativeAStar::findSlot(int aSquare, int aTime) const {
+	std::size_t mask = slotNodes.size() - 1;
+	std::uint64_t key = static_cast<std::uint64_t>(aTime) * xTiles * yTiles + aSquare;
+	std::size_t slot = static_cast<std::size_t>(GridMoves::hashKey(key)) & mask;
+	while (slotStamps[slot] == searchStamp) {
+		const searchNode &node = nodes[slotNodes[slot]];
+		if (node.square == aSquare && node.time == aTime) {
+			break;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return static_cast<int>(slot);
+}
+
+// Helper function that doubles the capacity of the node table
+void CooperativeAStar::growNodeTable() {
+	slotNodes.assign(slotNodes.size() * 2, 0);
+	slotStamps.assign(slotStamps.size() * 2, 0);
+	for (std::size_t node = 0; node < nodes.size(); node++) {
+		int slot = findSlot(nodes[node].square, nodes[node].time);
+		slotNodes[slot] = static_cast<int>(node);
+		slotStamps[slot] = searchStamp;
+	}
+}
+
+// Helper function that estimates the distance between two squares, never overestimating it
+double CooperativeAStar::heuristic(int anIndex, int anotherIndex) const {
+	return GridMoves::octileDistance(anIndex, anotherIndex, yTiles);
+}
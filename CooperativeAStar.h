@@ -0,0 +1,88 @@
+/*
+* Header file for the CooperativeAStar class.
+* Implementation of Windowed Cooperative A*: agents are planned one after another in (square, time) space over a short
+* window, each avoiding the paths reserved by the agents planned before it and the squares of the agents not yet planned.
+*/
+#pragma once
+#include "Position.h"
+#include "ReservationTable.h"
+#include "WallBitset.h"
+#include <cstdint>
+#include <vector>
+
+// Defines a CooperativeAgent struct, the current square and destination of one agent
+struct CooperativeAgent {
+	Position startPosition;
+	Position endPosition;
+};
+
+// Defines a CooperativePlan struct, the planned squares of one agent for a window
+struct CooperativePlan {
+	// Square of the agent at each time step from 0 (its start) to the window length
+	std::vector<Position> path;
+
+	// Flag indicating a path was planned; when false the agent waits at its start, colliding only if it shares that square
+	// with another agent or the square is a wall or outside the map
+	bool planned = false;
+};
+
+class CooperativeAStar {
+public:
+	// Constructor for CooperativeAStar object, given the walls of the map, the number of time steps planned per window,
+	// and the number of agents expected per window
+	CooperativeAStar(const WallBitset &, int = 16, int = 256);
+
+	// Method that plans the next window for every agent, in order of priority, returning the plan of each agent.
+	// Agents follow the first steps of their plans and are then replanned
+	std::vector<CooperativePlan> planWindow(const std::vector<CooperativeAgent> &);
+
+private:
+	// Defines a searchNode struct, the search state of one square at one time step
+	struct searchNode {
+		int square;
+		int time;
+		double startToNodeDistance;
+		int parent;
+		bool closed;
+	};
+
+	// Walls of the map being searched
+	const WallBitset &wallBitset;
+
+	// Number of squares horizontally and vertically
+	int xTiles;
+	int yTiles;
+
+	// Number of time steps planned per window
+	int windowLength;
+
+	// Squares reserved by the agents planned so far in the current window
+	ReservationTable reservationTable;
+
+	// Nodes created by the current search, found through an open-addressing table keyed by (time, square); slots
+	// written by an earlier search are recognized by their stamp, so the table never needs clearing
+	std::vector<searchNode> nodes;
+	std::vector<int> slotNodes;
+	std::vector<std::uint32_t> slotStamps;
+	std::uint32_t searchStamp = 0;
+
+	// Binary heap of (total distance, node) pairs, cheapest first; outdated entries are skipped when popped
+	typedef std::pair<double, int> heapEntry;
+	std::vector<heapEntry> openHeap;
+
+	// Helper function that searches the window for one agent against the reservation table, filling given vector with its
+	// square at each time step; returns false if every route is blocked
+	bool planAgent(const CooperativeAgent &, std::vector<int> &);
+
+	// Helper function that returns the node of a square at a time step, creating it if the current search has not yet
+	int getNode(int, int);
+
+	// Helper function that returns the slot of the node table holding a square at a time step, or the empty slot where it would go
+	int findSlot(int, int) const;
+
+	// Helper function that doubles the capacity of the node table
+	void growNodeTable();
+
+	// Helper function that estimates the distance between two squares, never overestimating it
+	double heuristic(int, int) const;
+};
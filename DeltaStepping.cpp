@@ -0,0 +1,289 @@
+/*
+* Implementation file for the DeltaStepping class.
+* Implementation of parallel delta-stepping and the sequential Dijkstra's algorithm it is checked against.
+*/
+#include "DeltaStepping.h"
+#include "GridMoves.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace {
+	// Positive doubles order the same way as their bit patterns, so distances can be kept in atomic integers
+	std::uint64_t toBits(double aDistance) {
+		std::uint64_t bits;
+		std::memcpy(&bits, &aDistance, sizeof(bits));
+		return bits;
+	}
+
+	double fromBits(std::uint64_t someBits) {
+		double distance;
+		std::memcpy(&distance, &someBits, sizeof(distance));
+		return distance;
+	}
+
+	// Lowers an atomic distance to a candidate, returning true if the candidate was smaller
+	bool atomicMinimum(std::atomic<std::uint64_t> &aDistance, std::uint64_t aCandidate) {
+		std::uint64_t current = aDistance.load(std::memory_order_relaxed);
+		while (aCandidate < current) {
+			if (aDistance.compare_exchange_weak(current, aCandidate, std::memory_order_relaxed)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Reusable barrier that holds threads until all of them have arrived
+	class ThreadBarrier {
+	public:
+		ThreadBarrier(int aThreadCount) : threadCount{ aThreadCount } {}
+
+		void wait() {
+			std::unique_lock<std::mutex> lock(mutex);
+			int arrivalGeneration = generation;
+			if (++arrived == threadCount) {
+				arrived = 0;
+				generation++;
+				released.notify_all();
+				return;
+			}
+			released.wait(lock, [&] { return generation != arrivalGeneration; });
+		}
+
+	private:
+		std::mutex mutex;
+		std::condition_variable released;
+		int threadCount;
+		int arrived = 0;
+		int generation = 0;
+	};
+}
+
+// Constructor for DeltaStepping object, given the walls of a map, the width of a distance bucket, and the number of threads
+DeltaStepping::DeltaStepping(const WallBitset &aWallBitset, double aBucketWidth, int aThreadCount) : wallBitset(aWallBitset), bucketWidth{ aBucketWidth }, threadCount{ aThreadCount } {
+	xTiles = std::get<0>(wallBitset.getNumberOfSquares());
+	yTiles = std::get<1>(wallBitset.getNumberOfSquares());
+
+	// Buckets narrower than the lightest edge only add rounds, and a width of zero or below (or NaN) makes bucket indices
+	// meaningless, so widths are kept at least that of a straight edge
+	if (!(bucketWidth >= GridMoves::straightWeight)) {
+		bucketWidth = GridMoves::straightWeight;
+	}
+
+	// Default to one thread per core
+	if (threadCount <= 0) {
+		threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+}
+
+// Method that computes distances from given position to every square, relaxing each bucket of distances across all threads
+// Squares are kept in buckets of width bucketWidth by tentative distance. The lowest non-empty bucket is relaxed by all
+// threads at once, with distances lowered by atomic minimum, until it stops changing; then the next bucket is taken.
+// The final distances are the unique fixed point also reached by Dijkstra's algorithm, so they match it bit for bit.
+DistanceField DeltaStepping::computeParallel(const Position &aSource) {
+	const int squareCount = xTiles * yTiles;
+	const std::uint64_t infiniteBits = toBits(INFINITY);
+	DistanceField field;
+	field.distances.assign(squareCount, INFINITY);
+	field.parents.assign(squareCount, -1);
+
+	// A wall or out of bounds source reaches nothing
+	if (!wallBitset.inBounds(aSource) || wallBitset.isWall(aSource)) {
+		return field;
+	}
+
+	// Tentative distance of each square, the distance each square was last relaxed with, and the last round it was queued in
+	std::unique_ptr<std::atomic<std::uint64_t>[]> distanceBits(new std::atomic<std::uint64_t>[squareCount]);
+	std::unique_ptr<std::atomic<std::uint64_t>[]> relaxedBits(new std::atomic<std::uint64_t>[squareCount]);
+	std::unique_ptr<std::atomic<std::uint32_t>[]> queuedRound(new std::atomic<std::uint32_t>[squareCount]);
+
+	// Each thread queues the squares it lowers into its own buckets; thread 0 gathers the next bucket between rounds.
+	// Relaxing a bucket only queues squares up to one diagonal edge beyond it, so few consecutive buckets ever hold squares
+	// at once, and bucket b is kept in slot b % ringSize of a fixed ring (with one spare slot against rounding)
+	const size_t ringSize = static_cast<size_t>(std::ceil(GridMoves::diagonalWeight / bucketWidth)) + 2;
+	std::vector<std::vector<std::vector<int>>> threadBuckets(threadCount, std::vector<std::vector<int>>(ringSize));
+	std::vector<int> frontier;
+	size_t currentBucket = 0;
+	std::uint32_t round = 0;
+	bool finished = false;
+	ThreadBarrier barrier(threadCount);
+
+	// Helper function that picks the squares to relax in the next round, or finishes once every bucket of the ring is empty
+	auto prepareRound = [&]() {
+		frontier.clear();
+		round++;
+		for (size_t step = 0; step < ringSize; step++) {
+			for (auto &buckets : threadBuckets) {
+				std::vector<int> &bucket = buckets[currentBucket % ringSize];
+				frontier.insert(frontier.end(), bucket.begin(), bucket.end());
+				bucket.clear();
+			}
+			if (!frontier.empty()) {
+				return;
+			}
+			currentBucket++;
+		}
+		finished = true;
+	};
+
+	auto worker = [&](int threadIndex) {
+		// Each thread initializes and finally reads back an equal slice of the squares
+		int sliceStart = static_cast<int>(static_cast<long long>(squareCount) * threadIndex / threadCount);
+		int sliceEnd = static_cast<int>(static_cast<long long>(squareCount) * (threadIndex + 1) / threadCount);
+		for (int i = sliceStart; i < sliceEnd; i++) {
+			distanceBits[i].store(infiniteBits, std::memory_order_relaxed);
+			relaxedBits[i].store(infiniteBits, std::memory_order_relaxed);
+			queuedRound[i].store(0, std::memory_order_relaxed);
+		}
+		std::vector<std::vector<int>> &buckets = threadBuckets[threadIndex];
+		barrier.wait();
+
+		if (threadIndex == 0) {
+			distanceBits[aSource.xPosition * yTiles + aSource.yPosition].store(toBits(0.0));
+			buckets[0].push_back(aSource.xPosition * yTiles + aSource.yPosition);
+		}
+
+		while (true) {
+			if (threadIndex == 0) {
+				prepareRound();
+			}
+			barrier.wait();
+			if (finished) {
+				break;
+			}
+
+			// Relax this thread's share of the frontier
+			size_t frontierStart = frontier.size() * threadIndex / threadCount;
+			size_t frontierEnd = frontier.size() * (threadIndex + 1) / threadCount;
+			for (size_t f = frontierStart; f < frontierEnd; f++) {
+				int vertex = frontier[f];
+				std::uint64_t vertexBits = distanceBits[vertex].load(std::memory_order_relaxed);
+
+				// Skip squares already relaxed with their current distance
+				if (relaxedBits[vertex].exchange(vertexBits, std::memory_order_relaxed) == vertexBits) {
+					continue;
+				}
+
+				double vertexDistance = fromBits(vertexBits);
+				int x = vertex / yTiles;
+				int y = vertex % yTiles;
+				for (int n = 0; n < GridMoves::moveCount; n++) {
+					Position neighborPosition = { x + GridMoves::moveX[n], y + GridMoves::moveY[n] };
+					if (!wallBitset.inBounds(neighborPosition) || wallBitset.isWall(neighborPosition)) {
+						continue;
+					}
+
+					int neighbor = neighborPosition.xPosition * yTiles + neighborPosition.yPosition;
+					double candidate = vertexDistance + GridMoves::moveWeight(n);
+					if (atomicMinimum(distanceBits[neighbor], toBits(candidate)) && queuedRound[neighbor].exchange(round, std::memory_order_relaxed) != round) {
+						// Never queue behind the current bucket, which is about to be left
+						size_t bucket = std::max(static_cast<size_t>(candidate / bucketWidth), currentBucket);
+						buckets[bucket % ringSize].push_back(neighbor);
+					}
+				}
+			}
+			barrier.wait();
+		}
+
+		// Read back final distances, then derive parents once every distance is known
+		for (int i = sliceStart; i < sliceEnd; i++) {
+			field.distances[i] = fromBits(distanceBits[i].load(std::memory_order_relaxed));
+		}
+		barrier.wait();
+		resolveParents(field, sliceStart, sliceEnd);
+	};
+
+	// Run the workers, the calling thread acting as thread 0
+	std::vector<std::thread> threads;
+	for (int t = 1; t < threadCount; t++) {
+		threads.emplace_back(worker, t);
+	}
+	worker(0);
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	return field;
+}
+
+// Method that computes distances from given position to every square with a sequential Dijkstra's algorithm
+DistanceField DeltaStepping::computeSequential(const Position &aSource) {
+	const int squareCount = xTiles * yTiles;
+	DistanceField field;
+	field.distances.assign(squareCount, INFINITY);
+	field.parents.assign(squareCount, -1);
+
+	// A wall or out of bounds source reaches nothing
+	if (!wallBitset.inBounds(aSource) || wallBitset.isWall(aSource)) {
+		return field;
+	}
+
+	// Priority queue of (distance, square) pairs, cheapest first; outdated entries are skipped when popped
+	typedef std::pair<double, int> queueEntry;
+	std::priority_queue<queueEntry, std::vector<queueEntry>, std::greater<queueEntry>> priorityQueue;
+	std::vector<bool> processed(squareCount, false);
+	field.distances[aSource.xPosition * yTiles + aSource.yPosition] = 0;
+	priorityQueue.emplace(0.0, aSource.xPosition * yTiles + aSource.yPosition);
+
+	while (!priorityQueue.empty()) {
+		int vertex = priorityQueue.top().second;
+		priorityQueue.pop();
+		if (processed[vertex]) {
+			continue;
+		}
+		processed[vertex] = true;
+
+		int x = vertex / yTiles;
+		int y = vertex % yTiles;
+		for (int n = 0; n < GridMoves::moveCount; n++) {
+			Position neighborPosition = { x + GridMoves::moveX[n], y + GridMoves::moveY[n] };
+			if (!wallBitset.inBounds(neighborPosition) || wallBitset.isWall(neighborPosition)) {
+				continue;
+			}
+
+			int neighbor = neighborPosition.xPosition * yTiles + neighborPosition.yPosition;
+			double candidate = field.distances[vertex] + GridMoves::moveWeight(n);
+			if (candidate < field.distances[neighbor]) {
+				field.distances[neighbor] = candidate;
+				priorityQueue.emplace(candidate, neighbor);
+			}
+		}
+	}
+
+	resolveParents(field, 0, squareCount);
+	return field;
+}
+
+// Helper function that fills parents for squares [first, last) from final distances
+// The parent is the first neighbor in move order realizing the distance, so ties resolve identically however distances were found
+void DeltaStepping::resolveParents(DistanceField &aField, int first, int last) const {
+	for (int vertex = first; vertex < last; vertex++) {
+		aField.parents[vertex] = -1;
+		if (aField.distances[vertex] == INFINITY || aField.distances[vertex] == 0) {
+			continue;
+		}
+
+		int x = vertex / yTiles;
+		int y = vertex % yTiles;
+		for (int n = 0; n < GridMoves::moveCount; n++) {
+			Position neighborPosition = { x + GridMoves::moveX[n], y + GridMoves::moveY[n] };
+			if (!wallBitset.inBounds(neighborPosition)) {
+				continue;
+			}
+
+			int neighbor = neighborPosition.xPosition * yTiles + neighborPosition.yPosition;
+			double candidate = aField.distances[neighbor] + GridMoves::moveWeight(n);
+			if (candidate == aField.distances[vertex]) {
+				aField.parents[vertex] = neighbor;
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,47 @@
+/*
+* Header file for the DeltaStepping class.
+* Computes the distance from one square to every square of a map, in parallel, using delta-stepping.
+*/
+#pragma once
+#include "Position.h"
+#include "WallBitset.h"
+#include <vector>
+
+// Defines a DistanceField struct, the result of a single-source search over a whole map
+// Both vectors are indexed by x * (squares vertically) + y
+struct DistanceField {
+	// Distance from the source to each square, INFINITY if the square is unreachable or a wall
+	std::vector<double> distances;
+
+	// Index of the square preceding each square on a shortest path, -1 for the source and unreachable squares
+	std::vector<int> parents;
+};
+
+class DeltaStepping {
+public:
+	// Constructor for DeltaStepping object, given the walls of a map, the width of a distance bucket (at least 1), and the number of threads (0 for one per core)
+	DeltaStepping(const WallBitset &, double = 4.0, int = 0);
+
+	// Method that computes distances from given position to every square, relaxing each bucket of distances across all threads
+	DistanceField computeParallel(const Position &);
+
+	// Method that computes distances from given position to every square with a sequential Dijkstra's algorithm
+	DistanceField computeSequential(const Position &);
+
+private:
+	// Walls of the map being searched
+	const WallBitset &wallBitset;
+
+	// Number of squares horizontally and vertically
+	int xTiles;
+	int yTiles;
+
+	// Width of the distance range covered by each bucket
+	double bucketWidth;
+
+	// Number of threads used by computeParallel
+	int threadCount;
+
+	// Helper function that fills parents for squares [first, last) from final distances
+	void resolveParents(DistanceField &, int, int) const;
+};
@@ -3,6 +3,7 @@
 * Implements Dijkstra's algorithm for pathfinding. Used with Graph and Grid class.
 */
 #include "Dijkstra.h"
+#include <algorithm>
 #include <iostream>
 
 // Constructor for Dijkstra object
@@ -14,35 +15,60 @@ void Dijkstra::findPath(const Position &aStartPosition, const Position& anEndPos
 	startPosition = aStartPosition;
 	endPosition = anEndPosition;
 
+	// An end position walled off from the start position is rejected without searching
+	if (!aGrid.isReachable(startPosition, endPosition)) {
+		endPositionFound = false;
+		return;
+	}
+
 	// Instantiate walls within Graph
 	for (const auto& wall : theWalls) {
 		graph.getVertex(wall).isWall = true;
 	}
 
-	// Determine cheaper route
-	auto startToVertexDistanceComparison = [](graphVertex *leftVertex, graphVertex *rightVertex) {
-		return leftVertex->startToVertexDistance < rightVertex->startToVertexDistance;
-	};
+	search(&aGrid, &aWindow);
+}
+
+// Calculate path using Dijkstra's algorithm given starting and ending position, using walls already set within the graph and drawing nothing
+void Dijkstra::findPath(const Position &aStartPosition, const Position &anEndPosition) {
+	// Define start and end positions for this object
+	startPosition = aStartPosition;
+	endPosition = anEndPosition;
+
+	search(nullptr, nullptr);
+}
+
+// Helper function for findPath that runs the search, drawing progress to the grid and window when they are given
+void Dijkstra::search(Grid *aGrid, sf::RenderWindow *aWindow) {
+	// Clear state left over from any previous search; the graph clears each vertex lazily as the search reaches it
+	priorityQueue = decltype(priorityQueue)();
+	graph.resetGraph();
+	endPositionFound = false;
 
 	// Define starting and ending squares as vertices
 	graphVertex* startVertex = &(graph.getVertex(startPosition));
 	startVertex->startToVertexDistance = 0; // This is starting vertex so distance is 0
-	graphVertex* endVertex = &(graph.getVertex(endPosition));
 
 	// Start Dijkstra's algorithm by pushing startVertex to priority queue
-	priorityQueue.emplace_back(startVertex);
+	priorityQueue.emplace(startVertex->startToVertexDistance, startVertex);
 
 	// Iterate while priority queue is not empty, indicating potential vertices to process, or until endPosition is found
 	while (!priorityQueue.empty() && !endPositionFound) {
-		priorityQueue.sort(startToVertexDistanceComparison); // Sort vertices within queue by their startToVertexDistance
-
 		// Copy cheapestVertex from priorityQueue, then pop it from the queue
-		graphVertex* currentVertex = priorityQueue.front();
-		priorityQueue.pop_front();
+		graphVertex* currentVertex = priorityQueue.top().second;
+		double queuedDistance = priorityQueue.top().first;
+		priorityQueue.pop();
+
+		// Skip vertices already processed or queued entries made outdated by a cheaper route
+		if (currentVertex->processedVertex || queuedDistance > currentVertex->startToVertexDistance) {
+			continue;
+		}
 
 		// This vertex has now been processed, color it as such within grid
 		currentVertex->processedVertex = true;
-		aGrid.colorProcessedSquare(currentVertex->vertexPosition);
+		if (aGrid != nullptr) {
+			aGrid->colorProcessedSquare(currentVertex->vertexPosition);
+		}
 
 		// Check if currentVertex is at endPosition
 		if (currentVertex->vertexPosition == endPosition) {
@@ -50,11 +76,15 @@ void Dijkstra::findPath(const Position &aStartPosition, const Position& anEndPos
 		}
 
 		// Draw Grid object to render window for this instance of computation
-		aGrid.drawGrid();
-		aWindow.display();
+		if (aGrid != nullptr && aWindow != nullptr) {
+			aGrid->drawGrid();
+			aWindow->display();
+		}
 
 		// Iterate through currentVertex's neighboringVertices
 		for (auto& neighbor : currentVertex->neighboringVertices) {
+			graph.refreshVertex(neighbor);
+
 			// If neighbor already processed or wall, skip this iteration
 			if (neighbor->processedVertex || neighbor->isWall) {
 				continue;
@@ -66,18 +96,11 @@ void Dijkstra::findPath(const Position &aStartPosition, const Position& anEndPos
 					neighbor->parent = currentVertex; // A vertex's parent is the cheapest vertex to reach it
 					neighbor->startToVertexDistance = approxStartToVertexDistance;
 
-					// Find neighbor in neighboringVertices of current Vertex
-					auto find = availableVertices.find(neighbor);
-					
-					// Conditional that indicates neighbor was not found in availableVertices
-					if (find == availableVertices.end()) {
-						// Indicate node is being processed
-						aGrid.colorProcessingSquare(neighbor->vertexPosition);
-
-						// Add neighbor to priority queue and availableVertices
-						priorityQueue.emplace_back(neighbor);
-						availableVertices.insert(neighbor);
+					// Indicate node is being processed, then add neighbor to priority queue
+					if (aGrid != nullptr) {
+						aGrid->colorProcessingSquare(neighbor->vertexPosition);
 					}
+					priorityQueue.emplace(neighbor->startToVertexDistance, neighbor);
 				}
 			}
 		}
@@ -101,6 +124,21 @@ void Dijkstra::loadPath(Grid& aGrid) {
 	}
 }
 
+// Accessor method for the squares of the computed path, ordered from start to end (empty if no path exists)
+std::vector<Position> Dijkstra::getPath() {
+	std::vector<Position> path;
+	if (!endPositionFound) {
+		return path;
+	}
+
+	// Walk parents back from endPosition, then reverse into start to end order
+	for (graphVertex *traversingVertex = &graph.getVertex(endPosition); traversingVertex != nullptr; traversingVertex = traversingVertex->parent) {
+		path.push_back(traversingVertex->vertexPosition);
+	}
+	std::reverse(path.begin(), path.end());
+	return path;
+}
+
 // Method that calculates Euclidean distance between two vertices
 double Dijkstra::vertexDistance(graphVertex *leftVertex, graphVertex *rightVertex) {
 	// Calculate differentials of x and y coordinates
@@ -5,8 +5,8 @@
 #pragma once
 #include "Graph.h"
 #include "Grid.h"
-#include <unordered_set>
-#include <list>
+#include <queue>
+#include <utility>
 
 class Dijkstra {
 public:
@@ -16,8 +16,14 @@ public:
 	// Method that calculates path using Dijkstra's algorithm given starting and ending position, wall positions, a grid, and a render window
 	void findPath(const Position &, const Position &, const std::vector<Position> &, Grid &, sf::RenderWindow &);
 
+	// Method that calculates path using Dijkstra's algorithm given starting and ending position, using walls already set within the graph and drawing nothing
+	void findPath(const Position &, const Position &);
+
 	// Method that draws path to the grid
 	void loadPath(Grid &);
+
+	// Accessor method for the squares of the computed path, ordered from start to end (empty if no path exists)
+	std::vector<Position> getPath();
 private:
 	// Each instance of Dijkstra operates on a Graph object
 	Graph &graph;
@@ -27,11 +33,12 @@ private:
 	Position endPosition;
 	bool endPositionFound = false; // Flag indicating endPosition reached and cessation of findPath
 	
-	// Priority queue for storing available vertices, sorted by least to greatest distance to startPosition
-	std::list<graphVertex *> priorityQueue;
+	// Priority queue of (startToVertexDistance, vertex) pairs, cheapest first; outdated entries are skipped when popped
+	typedef std::pair<double, graphVertex *> queueEntry;
+	std::priority_queue<queueEntry, std::vector<queueEntry>, std::greater<queueEntry>> priorityQueue;
 
-	// Unordered set which provides quick container for storing all available vertices
-	std::unordered_set<graphVertex *> availableVertices;
+	// Helper function for findPath that runs the search, drawing progress to the grid and window when they are given
+	void search(Grid *, sf::RenderWindow *);
 
 	// Helper function for findPath that calculates Euclidean distance between two vertices, used for finding more optimal paths when processing vertices
 	double vertexDistance(graphVertex *, graphVertex *);
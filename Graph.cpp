@@ -24,28 +24,56 @@ Graph::Graph(std::tuple<int, int> numSquares) {
 		for (int y = 0; y < yVertices; y++) {
 
 			if (y > 0)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[x * xVertices + (y - 1)]);
-			if (y < xVertices - 1)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[x * xVertices + (y + 1)]);
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[x * yVertices + (y - 1)]);
+			if (y < yVertices - 1)
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[x * yVertices + (y + 1)]);
 			if (x > 0)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[(x - 1) * xVertices + y]);
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[(x - 1) * yVertices + y]);
 			if (x < xVertices - 1)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[(x + 1) * xVertices + y]);
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[(x + 1) * yVertices + y]);
 
 
 			if (y > 0 && x > 0)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[(x - 1) * xVertices + (y - 1)]);
-			if (y < xVertices - 1 && x > 0)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[(x - 1) * xVertices + (y + 1)]);
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[(x - 1) * yVertices + (y - 1)]);
+			if (y < yVertices - 1 && x > 0)
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[(x - 1) * yVertices + (y + 1)]);
 			if (y > 0 && x < xVertices - 1)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[(x + 1) * xVertices + (y - 1)]);
-			if (y < xVertices - 1 && x < xVertices - 1)
-				vertices[x * xVertices + y].neighboringVertices.emplace_back(&vertices[(x + 1) * xVertices + (y + 1)]);
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[(x + 1) * yVertices + (y - 1)]);
+			if (y < yVertices - 1 && x < xVertices - 1)
+				vertices[x * yVertices + y].neighboringVertices.emplace_back(&vertices[(x + 1) * yVertices + (y + 1)]);
 		}
 	}
 }
 
-// Accessor method for getting vertex at given position
+// Accessor method for getting vertex at given position, with any state left over from an earlier search cleared
 graphVertex & Graph::getVertex(const Position& aPosition) {
-	return vertices[aPosition.xPosition * xVertices + aPosition.yPosition];
+	return *refreshVertex(&vertices[aPosition.xPosition * yVertices + aPosition.yPosition]);
+}
+
+// Method for clearing search state left over from an earlier search from given vertex, returning the vertex
+graphVertex * Graph::refreshVertex(graphVertex *aVertex) {
+	if (aVertex->searchStamp != searchCount) {
+		aVertex->parent = nullptr;
+		aVertex->processedVertex = false;
+		aVertex->vertexToEndDistance = INFINITY;
+		aVertex->startToVertexDistance = INFINITY;
+		aVertex->totalDistance = INFINITY;
+		aVertex->searchStamp = searchCount;
+	}
+	return aVertex;
+}
+
+// Method for resetting graph, clearing the results of a previous search while keeping walls
+// Only the search counter changes; each vertex is cleared by refreshVertex once a later search reaches it, so a reset
+// costs nothing however large the graph
+void Graph::resetGraph() {
+	searchCount++;
+
+	// Once the counter wraps, stamps from long ago would look current again, so clear every vertex for real
+	if (searchCount == 0) {
+		for (auto &vertex : vertices) {
+			vertex.searchStamp = 1;
+			refreshVertex(&vertex);
+		}
+	}
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 */
 #pragma once
 #include "Position.h"
+#include <cmath>
+#include <cstdint>
+#include <tuple>
 #include <vector>
 
 // Defines a Vertex struct, used for computations in Dijkstra's and Astar
@@ -28,6 +31,9 @@ struct graphVertex {
 	double startToVertexDistance = INFINITY;
 	double totalDistance = INFINITY; // Represents distance from start to end, used in Astar
 
+	// Search in which the state above was last written; state from an earlier search counts as cleared
+	std::uint32_t searchStamp = 0;
+
 	// Vector containing pointers to all neighboring vertices
 	std::vector<graphVertex*> neighboringVertices;
 };
@@ -40,13 +46,19 @@ private:
 	// Member variables containing number of horizontal and vertical vertices/squares
 	int xVertices;
 	int yVertices;
+
+	// Counter of searches, bumped by resetGraph so vertices are cleared lazily as a search reaches them
+	std::uint32_t searchCount = 0;
 public:
 	// Constructor method for Graph object
 	Graph(std::tuple<int, int>);
 
-	// Accessor method for getting vertex at given position
+	// Accessor method for getting vertex at given position, with any state left over from an earlier search cleared
 	graphVertex & getVertex(const Position &);
 
-	// Method for resetting graph
+	// Method for clearing search state left over from an earlier search from given vertex, returning the vertex
+	graphVertex * refreshVertex(graphVertex *);
+
+	// Method for resetting graph, clearing the results of a previous search in constant time
 	void resetGraph();
 };
\ No newline at end of file
@@ -7,7 +7,7 @@
 #include <thread>
 
 // Constructor method for Grid object
-Grid::Grid(int aWindowWidth, int aWindowHeight, sf::RenderWindow& aWindow) : windowWidth{ aWindowWidth }, windowHeight{ aWindowHeight }, window{ aWindow } {
+Grid::Grid(int aWindowWidth, int aWindowHeight, sf::RenderWindow& aWindow) : wallBitset(std::make_tuple(aWindowWidth / 30, aWindowHeight / 30)), componentIndex(wallBitset), windowWidth{ aWindowWidth }, windowHeight{ aWindowHeight }, window{ aWindow } {
 	// Calculate number of tiles given resolution and tile dimension
 	xTiles = windowWidth / 30;
 	yTiles = windowHeight / 30;
@@ -65,6 +65,8 @@ void Grid::setWall(sf::Vector2i anObstacle) {
 	if (getSquareColor(wallPosition) == wallColor) {
 		setSquareColor(wallPosition, freeColor);
 		walls.erase(std::remove(walls.begin(), walls.end(), wallPosition), walls.end());
+		wallBitset.setWall(wallPosition, false);
+		componentIndex.updateSquare(wallPosition); // Merges the components around the freed square
 		return;
 	}
 
@@ -81,6 +83,8 @@ void Grid::setWall(sf::Vector2i anObstacle) {
 	// If method reaches this point, position is validated, so add wall to grid
 	setSquareColor(wallPosition, wallColor);
 	walls.emplace_back(wallPosition);
+	wallBitset.setWall(wallPosition, true);
+	componentIndex.updateSquare(wallPosition); // Relabels only regions the new wall cuts off
 }
 
 // Method for explicitly defining ending position
@@ -165,6 +169,11 @@ void Grid::loadPath(const Position& aPosition, const Position& anotherPosition)
 	pathVertices.push_back(sf::Vertex(sf::Vector2f(anotherPosition.xPosition * 30 + (30 / 2), anotherPosition.yPosition * 30 + (30 / 2))));
 }
 
+// Method for determining whether a path between two positions can exist, answered from connected-component labels
+bool Grid::isReachable(const Position &aPosition, const Position &anotherPosition) const {
+	return componentIndex.connected(aPosition, anotherPosition);
+}
+
 // Accessor method for walls vector
 std::vector<Position> Grid::getWallPositions() const {
 	return walls;
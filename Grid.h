@@ -5,6 +5,8 @@
 #pragma once
 #include <SFML\Graphics.hpp>
 #include "Position.h"
+#include "WallBitset.h"
+#include "ComponentIndex.h"
 
 class Grid {
 public:
@@ -35,6 +37,9 @@ public:
 	// Method for loading tiles within computed path to path vector
 	void loadPath(const Position &, const Position &);
 
+	// Method for determining whether a path between two positions can exist, answered from connected-component labels
+	bool isReachable(const Position &, const Position &) const;
+
 	// Accessor method for walls vector
 	std::vector<Position> getWallPositions() const;
 
@@ -54,6 +59,10 @@ private:
 	// Vector storing positions of walls
 	std::vector<Position> walls;
 
+	// Packed walls and connected-component labels of free squares, kept up to date by setWall
+	WallBitset wallBitset;
+	ComponentIndex componentIndex;
+
 	// Vector containing SFML vertex representations of a computed path
 	std::vector<sf::Vertex> pathVertices;
 
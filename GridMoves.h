@@ -0,0 +1,46 @@
+/*
+* Defines the moves between squares shared by every planner working on a WallBitset.
+* Squares are indexed by x * (squares vertically) + y, and each square connects to its eight neighbors, as within Graph.
+*/
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+namespace GridMoves {
+	// Number of moves from a square
+	const int moveCount = 8;
+
+	// Offsets of the moves to each neighbor of a square, the four straight moves followed by the four diagonal moves
+	const int moveX[moveCount] = { 0, 0, -1, 1, -1, -1, 1, 1 };
+	const int moveY[moveCount] = { -1, 1, 0, 0, -1, 1, -1, 1 };
+
+	// Move weights, the Euclidean distances between square centers
+	const double straightWeight = 1.0;
+	const double diagonalWeight = std::sqrt(2.0);
+
+	// Helper function that determines whether given move is diagonal
+	inline bool isDiagonal(int aMove) {
+		return aMove >= 4;
+	}
+
+	// Helper function that returns the weight of given move
+	inline double moveWeight(int aMove) {
+		return isDiagonal(aMove) ? diagonalWeight : straightWeight;
+	}
+
+	// Helper function that calculates the octile distance between two square indices, given the number of squares vertically;
+	// this is the exact distance when no walls are in the way
+	inline double octileDistance(int anIndex, int anotherIndex, int aYTiles) {
+		int dx = std::abs(anIndex / aYTiles - anotherIndex / aYTiles);
+		int dy = std::abs(anIndex % aYTiles - anotherIndex % aYTiles);
+		return std::max(dx, dy) - std::min(dx, dy) + diagonalWeight * std::min(dx, dy);
+	}
+
+	// Helper function that scrambles a key by multiplicative hashing, so neighboring squares land far apart in a hash table;
+	// the result is masked to a power-of-two table size
+	inline std::uint64_t hashKey(std::uint64_t aKey) {
+		return (aKey * 0x9E3779B97F4A7C15ull) >> 32;
+	}
+}
@@ -0,0 +1,160 @@
+/*
+* Implementation file for the PathClient class, a command line client for PathServer.
+* Implementation of all public and private methods.
+*/
+#include "PathClient.h"
+#include "PathProtocol.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Constructor for PathClient object, given a connection to a server
+PathClient::PathClient(Connection &aConnection) : connection(aConnection) {}
+
+// Method that sends every command of an input stream without waiting for answers, printing responses to an output stream
+void PathClient::run(std::istream &anInput, std::ostream &anOutput) {
+	// Responses are printed by a separate thread while requests keep being sent
+	std::thread responseThread(&PathClient::printResponses, this, std::ref(anOutput));
+
+	std::string frames;
+	std::string line;
+	std::uint32_t requestId = 0;
+	while (std::getline(anInput, line)) {
+		std::istringstream command(line);
+		char commandType = 0;
+		if (!(command >> commandType)) {
+			continue; // Skip blank lines
+		}
+
+		std::int32_t xCoord = 0, yCoord = 0, xEnd = 0, yEnd = 0;
+		if ((commandType == 'A' || commandType == 'D' || commandType == 'T') && command >> xCoord >> yCoord >> xEnd >> yEnd) {
+			PathProtocol::putHeader(frames, 17, PathProtocol::queryRequest, requestId++);
+			PathProtocol::putUint8(frames, static_cast<std::uint8_t>(commandType));
+			PathProtocol::putInt32(frames, xCoord);
+			PathProtocol::putInt32(frames, yCoord);
+			PathProtocol::putInt32(frames, xEnd);
+			PathProtocol::putInt32(frames, yEnd);
+		}
+		else if (commandType == 'R' && command >> xCoord >> yCoord >> xEnd >> yEnd) {
+			// Budget is required, initial weight defaults to 3
+			std::uint32_t budgetMicroseconds = 0;
+			double initialWeight = 3.0;
+			if (!(command >> budgetMicroseconds)) {
+				std::cerr << "Unrecognized command: " << line << "\n";
+				continue;
+			}
+			command >> initialWeight;
+			PathProtocol::putHeader(frames, 24, PathProtocol::anytimeQueryRequest, requestId++);
+			PathProtocol::putInt32(frames, xCoord);
+			PathProtocol::putInt32(frames, yCoord);
+			PathProtocol::putInt32(frames, xEnd);
+			PathProtocol::putInt32(frames, yEnd);
+			PathProtocol::putUint32(frames, budgetMicroseconds);
+			PathProtocol::putUint32(frames, static_cast<std::uint32_t>(initialWeight * 1000.0 + 0.5));
+		}
+		else if ((commandType == 'W' || commandType == 'F') && command >> xCoord >> yCoord) {
+			PathProtocol::putHeader(frames, 9, PathProtocol::setWallRequest, requestId++);
+			PathProtocol::putInt32(frames, xCoord);
+			PathProtocol::putInt32(frames, yCoord);
+			PathProtocol::putUint8(frames, commandType == 'W' ? 1 : 0);
+		}
+		else if (commandType == 'Q') {
+			PathProtocol::putHeader(frames, 0, PathProtocol::shutdownRequest, requestId++);
+		}
+		else {
+			std::cerr << "Unrecognized command: " << line << "\n";
+			continue;
+		}
+
+		// Send once no more input is immediately available, so piped batches go out in as few writes as possible
+		if (anInput.rdbuf()->in_avail() <= 0 || frames.size() >= (1 << 16)) {
+			connection.send(frames.data(), static_cast<int>(frames.size()));
+			frames.clear();
+		}
+	}
+
+	// A final sync tells the response thread when everything has been answered
+	PathProtocol::putHeader(frames, 0, PathProtocol::syncRequest, requestId);
+	connection.send(frames.data(), static_cast<int>(frames.size()));
+	responseThread.join();
+}
+
+// Helper function that prints responses until a sync response arrives or the connection closes
+void PathClient::printResponses(std::ostream &anOutput) {
+	std::string input;
+	char chunk[1 << 16];
+
+	while (true) {
+		// Answer every complete frame within the buffer
+		size_t offset = 0;
+		while (input.size() - offset >= PathProtocol::headerSize) {
+			std::uint32_t payloadSize = PathProtocol::getUint32(&input[offset]);
+			if (input.size() - offset < PathProtocol::headerSize + payloadSize) {
+				break;
+			}
+
+			std::uint8_t opcode = static_cast<std::uint8_t>(input[offset + 4]);
+			std::uint32_t requestId = PathProtocol::getUint32(&input[offset + 5]);
+			const char *payload = &input[offset + PathProtocol::headerSize];
+			offset += PathProtocol::headerSize + payloadSize;
+
+			if (opcode == PathProtocol::syncResponse) {
+				anOutput.flush();
+				return;
+			}
+			if (opcode == PathProtocol::setWallResponse && payloadSize >= 1) {
+				anOutput << requestId << (payload[0] == PathProtocol::statusOk ? " wall ok\n" : " wall invalid\n");
+			}
+			if (opcode == PathProtocol::anytimePathResponse && payloadSize >= 13) {
+				std::uint8_t status = static_cast<std::uint8_t>(payload[0]);
+				std::uint32_t elapsedMicroseconds = PathProtocol::getUint32(payload + 1);
+				std::uint32_t boundThousandths = PathProtocol::getUint32(payload + 5);
+				std::uint32_t waypointCount = PathProtocol::getUint32(payload + 9);
+				if (status == PathProtocol::statusInvalid) {
+					anOutput << requestId << " invalid\n";
+				}
+				else if (status == PathProtocol::statusNoPath) {
+					anOutput << requestId << " no path " << elapsedMicroseconds << "us\n";
+				}
+				else if (status == PathProtocol::statusTimedOut) {
+					anOutput << requestId << " timed out " << elapsedMicroseconds << "us\n";
+				}
+				else {
+					anOutput << requestId << " path " << elapsedMicroseconds << "us bound " << boundThousandths / 1000.0 << " " << waypointCount << ":";
+					for (std::uint32_t i = 0; i < waypointCount && 13 + 8 * (i + 1) <= payloadSize; i++) {
+						anOutput << " " << PathProtocol::getInt32(payload + 13 + 8 * i) << "," << PathProtocol::getInt32(payload + 17 + 8 * i);
+					}
+					anOutput << "\n";
+				}
+			}
+			if (opcode == PathProtocol::pathResponse && payloadSize >= 9) {
+				std::uint8_t status = static_cast<std::uint8_t>(payload[0]);
+				std::uint32_t elapsedMicroseconds = PathProtocol::getUint32(payload + 1);
+				std::uint32_t waypointCount = PathProtocol::getUint32(payload + 5);
+				if (status == PathProtocol::statusInvalid) {
+					anOutput << requestId << " invalid\n";
+				}
+				else if (status == PathProtocol::statusNoPath) {
+					anOutput << requestId << " no path " << elapsedMicroseconds << "us\n";
+				}
+				else {
+					anOutput << requestId << " path " << elapsedMicroseconds << "us " << waypointCount << ":";
+					for (std::uint32_t i = 0; i < waypointCount && 9 + 8 * (i + 1) <= payloadSize; i++) {
+						anOutput << " " << PathProtocol::getInt32(payload + 9 + 8 * i) << "," << PathProtocol::getInt32(payload + 13 + 8 * i);
+					}
+					anOutput << "\n";
+				}
+			}
+		}
+		input.erase(0, offset);
+		anOutput.flush();
+
+		// Block until more bytes arrive, stopping once the server closes the connection
+		int received = connection.receive(chunk, sizeof(chunk));
+		if (received <= 0) {
+			return;
+		}
+		input.append(chunk, received);
+	}
+}
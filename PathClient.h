@@ -0,0 +1,27 @@
+/*
+* Header file for the PathClient class, a command line client for PathServer.
+* Translates text commands into pipelined binary frames and prints each response as it arrives.
+*/
+#pragma once
+#include "Connection.h"
+#include <istream>
+#include <ostream>
+
+class PathClient {
+public:
+	// Constructor for PathClient object, given a connection to a server
+	PathClient(Connection &);
+
+	// Method that sends every command of an input stream without waiting for answers, printing responses to an output stream
+	// Commands, one per line: "A|D|T sx sy ex ey" queries a path, "R sx sy ex ey budget [weight]" queries a path within a budget
+	// in microseconds (anytime A*, starting at the given weight), "W x y" adds a wall, "F x y" removes a wall, "Q" stops the server
+	// Returns once every response has been printed
+	void run(std::istream &, std::ostream &);
+
+private:
+	// Connection to the server
+	Connection &connection;
+
+	// Helper function that prints responses until a sync response arrives or the connection closes
+	void printResponses(std::ostream &);
+};
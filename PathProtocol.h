@@ -0,0 +1,70 @@
+/*
+* Defines the binary framing shared by PathServer and PathClient.
+* Every frame is a 9 byte header (payload length, opcode, request id) followed by its payload.
+* All integers are little-endian; requests may be pipelined and responses carry the id of their request.
+*/
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace PathProtocol {
+	// Size of the frame header: uint32 payload length, uint8 opcode, uint32 request id
+	const size_t headerSize = 9;
+
+	// Largest payload accepted, guarding against corrupt length fields
+	const std::uint32_t maxPayloadSize = 1 << 24;
+
+	// Request opcodes, sent by the client
+	const std::uint8_t queryRequest = 0x01;		// uint8 algorithm ('A', 'D', or 'T'), int32 start x, start y, end x, end y
+	const std::uint8_t setWallRequest = 0x02;	// int32 x, int32 y, uint8 wall flag (1 adds a wall, 0 removes it)
+	const std::uint8_t syncRequest = 0x03;		// No payload, answered once every earlier request has been answered
+	const std::uint8_t shutdownRequest = 0x04;	// No payload, stops the server
+	const std::uint8_t anytimeQueryRequest = 0x05;	// int32 start x, start y, end x, end y, uint32 budget in microseconds, uint32 initial weight in thousandths
+
+	// Response opcodes, sent by the server
+	const std::uint8_t pathResponse = 0x81;		// uint8 status, uint32 elapsed microseconds, uint32 waypoint count, then int32 x, y per waypoint
+	const std::uint8_t setWallResponse = 0x82;	// uint8 status
+	const std::uint8_t syncResponse = 0x83;		// No payload
+	const std::uint8_t anytimePathResponse = 0x84;	// uint8 status, uint32 elapsed microseconds, uint32 suboptimality bound in thousandths, uint32 waypoint count, then int32 x, y per waypoint
+
+	// Status codes carried by responses
+	const std::uint8_t statusOk = 0;
+	const std::uint8_t statusNoPath = 1;
+	const std::uint8_t statusInvalid = 2;
+	const std::uint8_t statusTimedOut = 3;	// Budget ran out before any path was found; a path may still exist
+
+	// Helper functions for appending little-endian integers to a buffer
+	inline void putUint8(std::string &aBuffer, std::uint8_t aValue) {
+		aBuffer.push_back(static_cast<char>(aValue));
+	}
+
+	inline void putUint32(std::string &aBuffer, std::uint32_t aValue) {
+		for (int i = 0; i < 4; i++) {
+			aBuffer.push_back(static_cast<char>((aValue >> (8 * i)) & 0xFF));
+		}
+	}
+
+	inline void putInt32(std::string &aBuffer, std::int32_t aValue) {
+		putUint32(aBuffer, static_cast<std::uint32_t>(aValue));
+	}
+
+	// Helper functions for reading little-endian integers from a buffer
+	inline std::uint32_t getUint32(const char *aBuffer) {
+		std::uint32_t value = 0;
+		for (int i = 0; i < 4; i++) {
+			value |= static_cast<std::uint32_t>(static_cast<unsigned char>(aBuffer[i])) << (8 * i);
+		}
+		return value;
+	}
+
+	inline std::int32_t getInt32(const char *aBuffer) {
+		return static_cast<std::int32_t>(getUint32(aBuffer));
+	}
+
+	// Appends a frame header to a buffer; the payload must follow immediately
+	inline void putHeader(std::string &aBuffer, std::uint32_t aPayloadSize, std::uint8_t anOpcode, std::uint32_t aRequestId) {
+		putUint32(aBuffer, aPayloadSize);
+		putUint8(aBuffer, anOpcode);
+		putUint32(aBuffer, aRequestId);
+	}
+}
@@ -0,0 +1,261 @@
+/*
+* Implementation file for the PathServer class, a headless pathfinding daemon.
+* Implementation of all public and private methods.
+*/
+#include "PathServer.h"
+#include "PathProtocol.h"
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+namespace {
+	// Responses are sent once every buffered frame is answered, or sooner once this many bytes are waiting
+	const size_t flushThreshold = 1 << 16;
+
+	// ...or once the oldest waiting response has been held this long, so slow queries in a batch stream back as they complete
+	const std::chrono::microseconds flushInterval(200);
+}
+
+// Constructor for PathServer object, given number of squares horizontally and vertically
+PathServer::PathServer(std::tuple<int, int> numSquares) : graph(numSquares), wallBitset(numSquares), componentIndex(wallBitset),
+	aStarAlgorithm(graph), dijkstraAlgorithm(graph), thetaStarAlgorithm(graph, wallBitset), anytimeAlgorithm(wallBitset) {}
+
+// Method for setting or clearing a wall at given position, returning false if position is invalid
+bool PathServer::setWall(const Position &aPosition, bool isWall) {
+	// Validate position
+	if (!wallBitset.inBounds(aPosition)) {
+		return false;
+	}
+
+	// Graph, bitset, and component labels must always agree
+	graph.getVertex(aPosition).isWall = isWall;
+	wallBitset.setWall(aPosition, isWall);
+	componentIndex.updateSquare(aPosition);
+	return true;
+}
+
+// Method for setting every position within given vector as a wall
+void PathServer::loadWalls(const std::vector<Position> &theWalls) {
+	for (const auto &wall : theWalls) {
+		if (wallBitset.inBounds(wall)) {
+			graph.getVertex(wall).isWall = true;
+			wallBitset.setWall(wall, true);
+		}
+	}
+
+	// Labeling once is cheaper than updating the labels wall by wall
+	componentIndex.rebuild();
+}
+
+// Method that answers frames from a connection until it closes; returns false once a shutdown frame is received
+// Frames are answered in order as soon as they are complete, so clients may pipeline any number of requests
+// Answers to cheap queries are batched into few writes, while any answer held past flushInterval (including the answer
+// to a query that itself ran longer) is written as soon as its query completes
+bool PathServer::serve(Connection &aConnection) {
+	std::string input;
+	std::string output;
+	std::vector<char> chunk(flushThreshold);
+	auto pendingSince = std::chrono::steady_clock::now(); // Time the frame behind the oldest waiting response began
+
+	while (true) {
+		// Block until more bytes arrive; a closed connection ends this session but not the server
+		int received = aConnection.receive(chunk.data(), static_cast<int>(chunk.size()));
+		if (received <= 0) {
+			return true;
+		}
+		input.append(chunk.data(), received);
+
+		// Answer every complete frame within the buffer
+		size_t offset = 0;
+		while (input.size() - offset >= PathProtocol::headerSize) {
+			std::uint32_t payloadSize = PathProtocol::getUint32(&input[offset]);
+
+			// A corrupt length field leaves the stream unrecoverable, so drop the connection
+			if (payloadSize > PathProtocol::maxPayloadSize) {
+				aConnection.send(output.data(), static_cast<int>(output.size()));
+				return true;
+			}
+
+			// Wait for the rest of an incomplete frame
+			if (input.size() - offset < PathProtocol::headerSize + payloadSize) {
+				break;
+			}
+
+			std::uint8_t opcode = static_cast<std::uint8_t>(input[offset + 4]);
+			std::uint32_t requestId = PathProtocol::getUint32(&input[offset + 5]);
+			if (output.empty()) {
+				pendingSince = std::chrono::steady_clock::now();
+			}
+			bool keepServing = handleFrame(opcode, requestId, &input[offset + PathProtocol::headerSize], payloadSize, output);
+			offset += PathProtocol::headerSize + payloadSize;
+
+			if (!keepServing) {
+				aConnection.send(output.data(), static_cast<int>(output.size()));
+				return false;
+			}
+
+			// Stream results of long batches back without waiting for the whole batch
+			if (output.size() >= flushThreshold || (!output.empty() && std::chrono::steady_clock::now() - pendingSince >= flushInterval)) {
+				if (!aConnection.send(output.data(), static_cast<int>(output.size()))) {
+					return true;
+				}
+				output.clear();
+			}
+		}
+		input.erase(0, offset);
+
+		// Send every response gathered from this read before blocking again
+		if (!output.empty()) {
+			if (!aConnection.send(output.data(), static_cast<int>(output.size()))) {
+				return true;
+			}
+			output.clear();
+		}
+	}
+}
+
+// Method that reads a map file: "<squares horizontally> <squares vertically>" followed by one "x y" pair per wall
+bool PathServer::readMap(const std::string &aPath, std::tuple<int, int> &numSquares, std::vector<Position> &theWalls) {
+	std::ifstream mapFile(aPath);
+	int xTiles = 0, yTiles = 0;
+	if (!(mapFile >> xTiles >> yTiles) || xTiles <= 0 || yTiles <= 0) {
+		return false;
+	}
+	numSquares = std::make_tuple(xTiles, yTiles);
+
+	int xCoord = 0, yCoord = 0;
+	while (mapFile >> xCoord >> yCoord) {
+		theWalls.push_back({ xCoord, yCoord });
+	}
+	return true;
+}
+
+// Helper function that answers a single frame, appending any response to the output buffer; returns false on shutdown
+bool PathServer::handleFrame(std::uint8_t anOpcode, std::uint32_t aRequestId, const char *aPayload, std::uint32_t aPayloadSize, std::string &anOutput) {
+	switch (anOpcode) {
+	case PathProtocol::queryRequest:
+		handleQuery(aRequestId, aPayload, aPayloadSize, anOutput);
+		break;
+
+	case PathProtocol::setWallRequest: {
+		std::uint8_t status = PathProtocol::statusInvalid;
+		if (aPayloadSize == 9) {
+			Position wallPosition = { PathProtocol::getInt32(aPayload), PathProtocol::getInt32(aPayload + 4) };
+			status = setWall(wallPosition, aPayload[8] != 0) ? PathProtocol::statusOk : PathProtocol::statusInvalid;
+		}
+		PathProtocol::putHeader(anOutput, 1, PathProtocol::setWallResponse, aRequestId);
+		PathProtocol::putUint8(anOutput, status);
+		break;
+	}
+
+	case PathProtocol::anytimeQueryRequest:
+		handleAnytimeQuery(aRequestId, aPayload, aPayloadSize, anOutput);
+		break;
+
+	case PathProtocol::syncRequest:
+		PathProtocol::putHeader(anOutput, 0, PathProtocol::syncResponse, aRequestId);
+		break;
+
+	case PathProtocol::shutdownRequest:
+		return false;
+
+	default:
+		// Unknown frames are skipped so newer clients can still talk to this server
+		break;
+	}
+	return true;
+}
+
+// Helper function that runs a path query and appends its response to the output buffer
+void PathServer::handleQuery(std::uint32_t aRequestId, const char *aPayload, std::uint32_t aPayloadSize, std::string &anOutput) {
+	auto queryStart = std::chrono::steady_clock::now();
+	std::uint8_t status = PathProtocol::statusInvalid;
+	std::vector<Position> path;
+
+	if (aPayloadSize == 17) {
+		char algorithm = aPayload[0];
+		Position startPosition = { PathProtocol::getInt32(aPayload + 1), PathProtocol::getInt32(aPayload + 5) };
+		Position endPosition = { PathProtocol::getInt32(aPayload + 9), PathProtocol::getInt32(aPayload + 13) };
+
+		// Both endpoints must be free squares of the map and the algorithm known, and walled off end positions need no search
+		bool validQuery = isFree(startPosition) && isFree(endPosition) && (algorithm == 'A' || algorithm == 'D' || algorithm == 'T');
+		if (validQuery && !componentIndex.connected(startPosition, endPosition)) {
+			status = PathProtocol::statusNoPath;
+		}
+		else if (validQuery) {
+			// Each search clears the results of the previous one lazily, the graph itself stays resident
+			if (algorithm == 'A') {
+				aStarAlgorithm.findPath(startPosition, endPosition);
+				path = aStarAlgorithm.getPath();
+			}
+			else if (algorithm == 'D') {
+				dijkstraAlgorithm.findPath(startPosition, endPosition);
+				path = dijkstraAlgorithm.getPath();
+			}
+			else {
+				thetaStarAlgorithm.findPath(startPosition, endPosition);
+				path = thetaStarAlgorithm.getPath();
+			}
+			status = path.empty() ? PathProtocol::statusNoPath : PathProtocol::statusOk;
+		}
+	}
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queryStart);
+
+	// Response payload: status, elapsed microseconds, waypoint count, waypoints
+	PathProtocol::putHeader(anOutput, static_cast<std::uint32_t>(9 + 8 * path.size()), PathProtocol::pathResponse, aRequestId);
+	PathProtocol::putUint8(anOutput, status);
+	PathProtocol::putUint32(anOutput, static_cast<std::uint32_t>(elapsed.count()));
+	PathProtocol::putUint32(anOutput, static_cast<std::uint32_t>(path.size()));
+	for (const auto &waypoint : path) {
+		PathProtocol::putInt32(anOutput, waypoint.xPosition);
+		PathProtocol::putInt32(anOutput, waypoint.yPosition);
+	}
+}
+
+// Helper function that runs a path query within a time budget and appends its response to the output buffer
+void PathServer::handleAnytimeQuery(std::uint32_t aRequestId, const char *aPayload, std::uint32_t aPayloadSize, std::string &anOutput) {
+	auto queryStart = std::chrono::steady_clock::now();
+	std::uint8_t status = PathProtocol::statusInvalid;
+	AnytimeResult result;
+
+	if (aPayloadSize == 24) {
+		Position startPosition = { PathProtocol::getInt32(aPayload), PathProtocol::getInt32(aPayload + 4) };
+		Position endPosition = { PathProtocol::getInt32(aPayload + 8), PathProtocol::getInt32(aPayload + 12) };
+		std::chrono::microseconds budget(PathProtocol::getUint32(aPayload + 16));
+		double initialWeight = PathProtocol::getUint32(aPayload + 20) / 1000.0;
+
+		// Both endpoints must be free squares of the map, and walled off end positions need no search
+		if (isFree(startPosition) && isFree(endPosition) && !componentIndex.connected(startPosition, endPosition)) {
+			status = PathProtocol::statusNoPath;
+		}
+		else if (isFree(startPosition) && isFree(endPosition)) {
+			result = anytimeAlgorithm.findPath(startPosition, endPosition, budget, initialWeight);
+			if (result.timedOut) {
+				status = PathProtocol::statusTimedOut;
+			}
+			else {
+				status = result.path.empty() ? PathProtocol::statusNoPath : PathProtocol::statusOk;
+			}
+		}
+	}
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queryStart);
+	std::uint32_t boundThousandths = result.path.empty() ? 0xFFFFFFFF : static_cast<std::uint32_t>(std::ceil(result.suboptimalityBound * 1000.0));
+
+	// Response payload: status, elapsed microseconds, suboptimality bound, waypoint count, waypoints
+	PathProtocol::putHeader(anOutput, static_cast<std::uint32_t>(13 + 8 * result.path.size()), PathProtocol::anytimePathResponse, aRequestId);
+	PathProtocol::putUint8(anOutput, status);
+	PathProtocol::putUint32(anOutput, static_cast<std::uint32_t>(elapsed.count()));
+	PathProtocol::putUint32(anOutput, boundThousandths);
+	PathProtocol::putUint32(anOutput, static_cast<std::uint32_t>(result.path.size()));
+	for (const auto &waypoint : result.path) {
+		PathProtocol::putInt32(anOutput, waypoint.xPosition);
+		PathProtocol::putInt32(anOutput, waypoint.yPosition);
+	}
+}
+
+// Helper function for determining whether a position lies within the map and is not a wall
+bool PathServer::isFree(const Position &aPosition) const {
+	return wallBitset.inBounds(aPosition) && !wallBitset.isWall(aPosition);
+}
@@ -0,0 +1,58 @@
+/*
+* Header file for the PathServer class, a headless pathfinding daemon.
+* Keeps a map resident and answers pipelined binary queries (see PathProtocol.h) over a Connection.
+*/
+#pragma once
+#include "AStar.h"
+#include "AnytimeAStar.h"
+#include "ComponentIndex.h"
+#include "Connection.h"
+#include "Dijkstra.h"
+#include "Graph.h"
+#include "ThetaStar.h"
+#include "WallBitset.h"
+#include <string>
+
+class PathServer {
+public:
+	// Constructor for PathServer object, given number of squares horizontally and vertically
+	PathServer(std::tuple<int, int>);
+
+	// Method for setting or clearing a wall at given position, returning false if position is invalid
+	bool setWall(const Position &, bool);
+
+	// Method for setting every position within given vector as a wall
+	void loadWalls(const std::vector<Position> &);
+
+	// Method that answers frames from a connection until it closes; returns false once a shutdown frame is received
+	bool serve(Connection &);
+
+	// Method that reads a map file: "<squares horizontally> <squares vertically>" followed by one "x y" pair per wall
+	static bool readMap(const std::string &, std::tuple<int, int> &, std::vector<Position> &);
+
+private:
+	// Resident representations of the map, built once and shared by every query
+	Graph graph;
+	WallBitset wallBitset;
+
+	// Connected-component labels of free squares, letting walled off queries be answered without searching
+	ComponentIndex componentIndex;
+
+	// Algorithm instances operating on the resident graph
+	AStar aStarAlgorithm;
+	Dijkstra dijkstraAlgorithm;
+	ThetaStar thetaStarAlgorithm;
+	AnytimeAStar anytimeAlgorithm;
+
+	// Helper function that answers a single frame, appending any response to the output buffer; returns false on shutdown
+	bool handleFrame(std::uint8_t, std::uint32_t, const char *, std::uint32_t, std::string &);
+
+	// Helper function that runs a path query and appends its response to the output buffer
+	void handleQuery(std::uint32_t, const char *, std::uint32_t, std::string &);
+
+	// Helper function that runs a path query within a time budget and appends its response to the output buffer
+	void handleAnytimeQuery(std::uint32_t, const char *, std::uint32_t, std::string &);
+
+	// Helper function for determining whether a position lies within the map and is not a wall
+	bool isFree(const Position &) const;
+};
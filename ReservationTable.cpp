@@ -0,0 +1,126 @@
+/*
+* Implementation file for the ReservationTable class, the space-time reservations shared by cooperatively planned agents.
+* Implementation of all public and private methods.
+*/
+#include "ReservationTable.h"
+#include "GridMoves.h"
+#include <algorithm>
+#include <cstdint>
+
+// Constructor for ReservationTable object, given the number of time steps in a window and the expected number of agents
+ReservationTable::ReservationTable(int aWindowLength, int anExpectedAgents) : windowLength{ aWindowLength } {
+	// Each agent reserves one square per time step; keep every slice at most half full
+	size_t capacity = 16;
+	while (capacity < static_cast<size_t>(anExpectedAgents) * 2) {
+		capacity *= 2;
+	}
+	timeSlices.assign(windowLength + 1, std::vector<reservation>(capacity));
+	sliceCounts.assign(windowLength + 1, 0);
+}
+
+// Method for removing every reservation, ready for the next window
+void ReservationTable::clear() {
+	for (int time = 0; time <= windowLength; time++) {
+		std::fill(timeSlices[time].begin(), timeSlices[time].end(), reservation());
+		sliceCounts[time] = 0;
+	}
+}
+
+// Method for reserving a square at a time step, given the square its agent arrives from; returns false if already reserved
+bool ReservationTable::reserve(int aTime, int aSquare, int aPreviousSquare) {
+	// Times outside of the window are never reserved
+	if (aTime < 0 || aTime > windowLength) {
+		return false;
+	}
+
+	// Keep the slice at most half full so probes stay short
+	if ((sliceCounts[aTime] + 1) * 2 > static_cast<int>(timeSlices[aTime].size())) {
+		growSlice(aTime);
+	}
+
+	std::vector<reservation> &timeSlice = timeSlices[aTime];
+	int slot = findSlot(timeSlice, aSquare);
+	if (timeSlice[slot].square == aSquare) {
+		return false;
+	}
+	timeSlice[slot].square = aSquare;
+	timeSlice[slot].previousSquare = aPreviousSquare;
+	sliceCounts[aTime]++;
+	return true;
+}
+
+// Method for removing the reservation of a square at a time step, if there is one
+// Later entries of the same probe run are shifted back into the hole, so lookups never stop early at an empty slot
+void ReservationTable::release(int aTime, int aSquare) {
+	if (aTime < 0 || aTime > windowLength) {
+		return;
+	}
+	std::vector<reservation> &timeSlice = timeSlices[aTime];
+	size_t mask = timeSlice.size() - 1;
+	size_t hole = static_cast<size_t>(findSlot(timeSlice, aSquare));
+	if (timeSlice[hole].square != aSquare) {
+		return;
+	}
+
+	for (size_t slot = (hole + 1) & mask; timeSlice[slot].square != -1; slot = (slot + 1) & mask) {
+		// An entry may fill the hole unless its home slot lies after the hole, in probe order
+		size_t home = homeSlot(timeSlice, timeSlice[slot].square);
+		if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+			timeSlice[hole] = timeSlice[slot];
+			hole = slot;
+		}
+	}
+	timeSlice[hole] = reservation();
+	sliceCounts[aTime]--;
+}
+
+// Accessor method for determining whether a square is reserved at a time step
+bool ReservationTable::isReserved(int aTime, int aSquare) const {
+	if (aTime < 0 || aTime > windowLength) {
+		return false;
+	}
+	const std::vector<reservation> &timeSlice = timeSlices[aTime];
+	return timeSlice[findSlot(timeSlice, aSquare)].square == aSquare;
+}
+
+// Accessor method for determining whether an agent moves from one square to another, arriving at a time step
+// Used to reject moves that swap places with another agent, or cross its diagonal move through the same corner
+bool ReservationTable::isMove(int aTime, int aFromSquare, int aToSquare) const {
+	if (aTime < 0 || aTime > windowLength) {
+		return false;
+	}
+	const std::vector<reservation> &timeSlice = timeSlices[aTime];
+	const reservation &arrival = timeSlice[findSlot(timeSlice, aToSquare)];
+	return arrival.square == aToSquare && arrival.previousSquare == aFromSquare;
+}
+
+// Accessor method for the number of time steps in a window
+int ReservationTable::getWindowLength() const {
+	return windowLength;
+}
+
+// Helper function that returns the slot holding a square within a time slice, or the empty slot where it would go
+int ReservationTable::findSlot(const std::vector<reservation> &aTimeSlice, int aSquare) const {
+	size_t mask = aTimeSlice.size() - 1;
+	size_t slot = homeSlot(aTimeSlice, aSquare);
+	while (aTimeSlice[slot].square != -1 && aTimeSlice[slot].square != aSquare) {
+		slot = (slot + 1) & mask;
+	}
+	return static_cast<int>(slot);
+}
+
+// Helper function that returns the slot of a time slice where probing for a square begins
+size_t ReservationTable::homeSlot(const std::vector<reservation> &aTimeSlice, int aSquare) const {
+	return static_cast<size_t>(GridMoves::hashKey(static_cast<std::uint32_t>(aSquare))) & (aTimeSlice.size() - 1);
+}
+
+// Helper function that doubles the capacity of a time slice
+void ReservationTable::growSlice(int aTime) {
+	std::vector<reservation> previousSlice(timeSlices[aTime].size() * 2);
+	previousSlice.swap(timeSlices[aTime]);
+	for (const auto &entry : previousSlice) {
+		if (entry.square != -1) {
+			timeSlices[aTime][findSlot(timeSlices[aTime], entry.square)] = entry;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+/*
+* Header file for the ReservationTable class, the space-time reservations shared by cooperatively planned agents.
+* Holds one compact open-addressing hash table of reserved squares per time step of the planning window.
+*/
+#pragma once
+#include <cstddef>
+#include <vector>
+
+class ReservationTable {
+public:
+	// Constructor for ReservationTable object, given the number of time steps in a window and the expected number of agents
+	ReservationTable(int, int);
+
+	// Method for removing every reservation, ready for the next window
+	void clear();
+
+	// Method for reserving a square at a time step, given the square its agent arrives from; returns false if already reserved
+	bool reserve(int, int, int);
+
+	// Method for removing the reservation of a square at a time step, if there is one
+	void release(int, int);
+
+	// Accessor method for determining whether a square is reserved at a time step
+	bool isReserved(int, int) const;
+
+	// Accessor method for determining whether an agent moves from one square to another, arriving at a time step
+	bool isMove(int, int, int) const;
+
+	// Accessor method for the number of time steps in a window
+	int getWindowLength() const;
+
+private:
+	// Defines a reservation struct, one reserved square at one time step
+	struct reservation {
+		int square = -1;			// Reserved square, -1 for an empty slot
+		int previousSquare = -1;	// Square the reserving agent occupied one time step earlier
+	};
+
+	// Number of time steps in a window; times 0 to windowLength (inclusive) can be reserved
+	int windowLength;
+
+	// Reservations of each time step, stored by open addressing with linear probing in a power-of-two table
+	std::vector<std::vector<reservation>> timeSlices;
+	std::vector<int> sliceCounts;
+
+	// Helper function that returns the slot holding a square within a time slice, or the empty slot where it would go
+	int findSlot(const std::vector<reservation> &, int) const;
+
+	// Helper function that returns the slot of a time slice where probing for a square begins
+	std::size_t homeSlot(const std::vector<reservation> &, int) const;
+
+	// Helper function that doubles the capacity of a time slice
+	void growSlice(int);
+};
@@ -0,0 +1,179 @@
+/*
+* Implementation file for the ThetaStar class.
+* Implements Lazy Theta* for any-angle pathfinding. Used with Graph, Grid, and WallBitset classes.
+*/
+#include "ThetaStar.h"
+#include <algorithm>
+#include <cmath>
+
+// Constructor for ThetaStar object
+ThetaStar::ThetaStar(Graph &graph, WallBitset &wallBitset) : graph(graph), wallBitset(wallBitset) {}
+
+// Method that calculates an any-angle path using Lazy Theta* given start and end position, walls, a grid, and an SFML render window
+void ThetaStar::findPath(const Position &aStartPosition, const Position &anEndPosition, const std::vector<Position> &theWalls, Grid &aGrid, sf::RenderWindow &aWindow) {
+	// Define start and end positions of this instance
+	startPosition = aStartPosition;
+	endPosition = anEndPosition;
+
+	// An end position walled off from the start position is rejected without searching
+	if (!aGrid.isReachable(startPosition, endPosition)) {
+		endPositionFound = false;
+		return;
+	}
+
+	// Instantiate the wall flag for each wall, both within the graph and within the packed walls
+	for (const auto &wall : theWalls) {
+		graph.getVertex(wall).isWall = true;
+	}
+	wallBitset.loadWalls(theWalls);
+
+	search(&aGrid, &aWindow);
+}
+
+// Method that calculates an any-angle path given start and end position, using walls already set within the graph and bitset and drawing nothing
+void ThetaStar::findPath(const Position &aStartPosition, const Position &anEndPosition) {
+	// Define start and end positions of this instance
+	startPosition = aStartPosition;
+	endPosition = anEndPosition;
+
+	search(nullptr, nullptr);
+}
+
+// Helper function for findPath that runs the search, drawing progress to the grid and window when they are given
+// Each vertex optimistically inherits the parent of the vertex that reached it; line of sight is only verified once
+// the vertex is expanded, so far fewer line-of-sight checks are made than with plain Theta*
+void ThetaStar::search(Grid *aGrid, sf::RenderWindow *aWindow) {
+	// Clear state left over from any previous search; the graph clears each vertex lazily as the search reaches it
+	priorityQueue = decltype(priorityQueue)();
+	graph.resetGraph();
+	endPositionFound = false;
+
+	// Define starting and ending squares as vertices
+	graphVertex *startingVertex = &(graph.getVertex(startPosition));
+	graphVertex *endingVertex = &(graph.getVertex(endPosition));
+	startingVertex->startToVertexDistance = 0;
+	startingVertex->vertexToEndDistance = vertexDistance(startingVertex, endingVertex);
+	startingVertex->totalDistance = startingVertex->vertexToEndDistance;
+
+	// Start Lazy Theta* by pushing startingVertex to the priority queue
+	priorityQueue.emplace(startingVertex->totalDistance, startingVertex);
+
+	// Iterate while priority queue is not empty, indicating potential vertices to process, or until endPosition is found
+	while (!priorityQueue.empty() && !endPositionFound) {
+		// Copy cheapest vertex from priority queue, then pop it
+		graphVertex *currentVertex = priorityQueue.top().second;
+		double queuedDistance = priorityQueue.top().first;
+		priorityQueue.pop();
+
+		// Skip vertices already processed or queued entries made outdated by a cheaper route
+		if (currentVertex->processedVertex || queuedDistance > currentVertex->totalDistance) {
+			continue;
+		}
+
+		// Verify the assumed parent, then mark the vertex processed and color it accordingly in aGrid
+		setVertex(currentVertex);
+		currentVertex->processedVertex = true;
+		if (aGrid != nullptr) {
+			aGrid->colorProcessedSquare(currentVertex->vertexPosition);
+		}
+
+		// Check if currentVertex is at endPosition
+		if (currentVertex->vertexPosition == endPosition) {
+			endPositionFound = true; // Exit condition
+		}
+
+		// Update grid representation
+		if (aGrid != nullptr && aWindow != nullptr) {
+			aGrid->drawGrid();
+			aWindow->display();
+		}
+
+		// Neighbors are reached straight from the parent of currentVertex whenever possible (the starting vertex is its own origin)
+		graphVertex *originVertex = currentVertex->parent != nullptr ? currentVertex->parent : currentVertex;
+
+		// Iterate through neighboring vertices
+		for (auto &neighbor : currentVertex->neighboringVertices) {
+			graph.refreshVertex(neighbor);
+
+			// If neighbor is already processed or a wall, skip iteration
+			if (neighbor->processedVertex || neighbor->isWall) {
+				continue;
+			}
+
+			double approxStartToVertexDistance = originVertex->startToVertexDistance + vertexDistance(originVertex, neighbor);
+
+			// This condition indicates a more optimal path exists from startingVertex to the neighbor
+			if (approxStartToVertexDistance < neighbor->startToVertexDistance) {
+				neighbor->parent = originVertex; // Assumed visible until neighbor is expanded
+				neighbor->startToVertexDistance = approxStartToVertexDistance;
+				neighbor->vertexToEndDistance = vertexDistance(neighbor, endingVertex);
+				neighbor->totalDistance = neighbor->startToVertexDistance + neighbor->vertexToEndDistance;
+
+				// Indicate this neighbor is being processed in grid representation and add it to priority queue
+				if (aGrid != nullptr) {
+					aGrid->colorProcessingSquare(neighbor->vertexPosition);
+				}
+				priorityQueue.emplace(neighbor->totalDistance, neighbor);
+			}
+		}
+	}
+}
+
+// Method that adds path to aGrid's path vector
+void ThetaStar::loadPath(Grid &aGrid) {
+	// Define vertex to traverse grid, instantiated at endPosition
+	graphVertex *traversingVertex = &graph.getVertex(endPosition);
+
+	// Iterate through vertices' parents, starting at end position; each segment may span many squares
+	while (traversingVertex->parent != nullptr) {
+		aGrid.loadPath(traversingVertex->vertexPosition, traversingVertex->parent->vertexPosition);
+		traversingVertex = traversingVertex->parent;
+	}
+}
+
+// Accessor method for the waypoints of the computed path, ordered from start to end (empty if no path exists)
+std::vector<Position> ThetaStar::getPath() {
+	std::vector<Position> path;
+	if (!endPositionFound) {
+		return path;
+	}
+
+	// Walk parents back from endPosition, then reverse into start to end order
+	for (graphVertex *traversingVertex = &graph.getVertex(endPosition); traversingVertex != nullptr; traversingVertex = traversingVertex->parent) {
+		path.push_back(traversingVertex->vertexPosition);
+	}
+	std::reverse(path.begin(), path.end());
+	return path;
+}
+
+// Helper function that verifies a vertex's assumed parent is visible, repairing it from processed neighbors otherwise
+void ThetaStar::setVertex(graphVertex *aVertex) {
+	// Starting vertex has no parent to verify
+	if (aVertex->parent == nullptr || wallBitset.hasLineOfSight(aVertex->parent->vertexPosition, aVertex->vertexPosition)) {
+		return;
+	}
+
+	// Parent is hidden, so fall back to the cheapest processed neighbor (at least one exists, the vertex that reached it)
+	aVertex->startToVertexDistance = INFINITY;
+	for (auto &neighbor : aVertex->neighboringVertices) {
+		if (!graph.refreshVertex(neighbor)->processedVertex || neighbor->isWall) {
+			continue;
+		}
+		double approxStartToVertexDistance = neighbor->startToVertexDistance + vertexDistance(neighbor, aVertex);
+		if (approxStartToVertexDistance < aVertex->startToVertexDistance) {
+			aVertex->parent = neighbor;
+			aVertex->startToVertexDistance = approxStartToVertexDistance;
+		}
+	}
+	aVertex->totalDistance = aVertex->startToVertexDistance + aVertex->vertexToEndDistance;
+}
+
+// Method that calculates Euclidean distance between two vertices
+double ThetaStar::vertexDistance(graphVertex *leftVertex, graphVertex *rightVertex) {
+	// Calculate differentials
+	int dx = (leftVertex->vertexPosition.xPosition - rightVertex->vertexPosition.xPosition);
+	int dy = (leftVertex->vertexPosition.yPosition - rightVertex->vertexPosition.yPosition);
+
+	// Return Euclidean distance
+	return sqrt((dx * dx) + (dy * dy));
+}
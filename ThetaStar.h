@@ -0,0 +1,51 @@
+/*
+* Header file for the ThetaStar class.
+* Implementation of the Lazy Theta* any-angle algorithm for use with the Grid, Graph, and WallBitset class.
+*/
+#pragma once
+#include "Graph.h"
+#include "Grid.h"
+#include "WallBitset.h"
+#include <queue>
+#include <utility>
+
+class ThetaStar {
+public:
+	// Constructor for ThetaStar object
+	ThetaStar(Graph &, WallBitset &);
+
+	// Method that calculates an any-angle path using Lazy Theta* given start and end position, walls, a grid, and an SFML render window
+	void findPath(const Position &, const Position &, const std::vector<Position> &, Grid &, sf::RenderWindow &);
+
+	// Method that calculates an any-angle path given start and end position, using walls already set within the graph and bitset and drawing nothing
+	void findPath(const Position &, const Position &);
+
+	// Assigns the any-angle path to the pathVertices vector within Grid
+	void loadPath(Grid &);
+
+	// Accessor method for the waypoints of the computed path, ordered from start to end (empty if no path exists)
+	std::vector<Position> getPath();
+
+private:
+	// Each instance of ThetaStar operates upon a graph and the packed walls used for line-of-sight checks
+	Graph &graph;
+	WallBitset &wallBitset;
+
+	// ThetaStar must have access to start and end positions to calculate path
+	Position startPosition;
+	Position endPosition;
+	bool endPositionFound = false; // Flag indicating endPosition reached and cessation of findPath
+
+	// Priority queue of (totalDistance, vertex) pairs, cheapest first; outdated entries are skipped when popped
+	typedef std::pair<double, graphVertex *> queueEntry;
+	std::priority_queue<queueEntry, std::vector<queueEntry>, std::greater<queueEntry>> priorityQueue;
+
+	// Helper function for findPath that runs the search, drawing progress to the grid and window when they are given
+	void search(Grid *, sf::RenderWindow *);
+
+	// Helper function for findPath that verifies a vertex's assumed parent is visible, repairing it from processed neighbors otherwise
+	void setVertex(graphVertex *);
+
+	// Helper function for findPath that calculates Euclidean distance between two vertices
+	double vertexDistance(graphVertex *, graphVertex *);
+};
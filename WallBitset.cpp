@@ -0,0 +1,175 @@
+/*
+* Implementation file for the WallBitset class, a packed bit representation of the walls within a Grid.
+* Implementation of all public and private methods.
+*/
+#include "WallBitset.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+	// Floor and ceiling of integer division for a positive divisor, used for locating squares crossed by a line
+	int floorDivide(int numerator, int denominator) {
+		return numerator >= 0 ? numerator / denominator : -((-numerator + denominator - 1) / denominator);
+	}
+
+	int ceilDivide(int numerator, int denominator) {
+		return -floorDivide(-numerator, denominator);
+	}
+}
+
+// Constructor method for WallBitset object
+WallBitset::WallBitset(std::tuple<int, int> numSquares) {
+	// Assign values of 2-tuple numSquares to corresponding x and yTiles variables
+	xTiles = std::get<0>(numSquares);
+	yTiles = std::get<1>(numSquares);
+
+	// Each column and row is rounded up to a whole number of 64-bit words
+	wordsPerColumn = (yTiles + 63) / 64;
+	wordsPerRow = (xTiles + 63) / 64;
+	columnBits.assign(static_cast<size_t>(xTiles) * wordsPerColumn, 0);
+	rowBits.assign(static_cast<size_t>(yTiles) * wordsPerRow, 0);
+}
+
+// Method for setting or clearing a wall at given position
+void WallBitset::setWall(const Position &aPosition, bool isWall) {
+	// Validate position
+	if (!inBounds(aPosition)) {
+		return;
+	}
+
+	std::uint64_t columnMask = std::uint64_t(1) << (aPosition.yPosition & 63);
+	std::uint64_t rowMask = std::uint64_t(1) << (aPosition.xPosition & 63);
+	std::uint64_t &columnWord = columnBits[static_cast<size_t>(aPosition.xPosition) * wordsPerColumn + (aPosition.yPosition >> 6)];
+	std::uint64_t &rowWord = rowBits[static_cast<size_t>(aPosition.yPosition) * wordsPerRow + (aPosition.xPosition >> 6)];
+
+	// Both layouts must always agree
+	if (isWall) {
+		columnWord |= columnMask;
+		rowWord |= rowMask;
+	}
+	else {
+		columnWord &= ~columnMask;
+		rowWord &= ~rowMask;
+	}
+}
+
+// Method for setting every position within given vector as a wall
+void WallBitset::loadWalls(const std::vector<Position> &theWalls) {
+	for (const auto &wall : theWalls) {
+		setWall(wall, true);
+	}
+}
+
+// Method for clearing all walls
+void WallBitset::clearWalls() {
+	std::fill(columnBits.begin(), columnBits.end(), 0);
+	std::fill(rowBits.begin(), rowBits.end(), 0);
+}
+
+// Accessor method for determining whether given position is a wall
+bool WallBitset::isWall(const Position &aPosition) const {
+	std::uint64_t columnWord = columnBits[static_cast<size_t>(aPosition.xPosition) * wordsPerColumn + (aPosition.yPosition >> 6)];
+	return (columnWord >> (aPosition.yPosition & 63)) & 1;
+}
+
+// Accessor method for determining whether given position lies within the bitset
+bool WallBitset::inBounds(const Position &aPosition) const {
+	return aPosition.xPosition >= 0 && aPosition.yPosition >= 0 && aPosition.xPosition < xTiles && aPosition.yPosition < yTiles;
+}
+
+// Method that determines whether a straight line between the centers of two squares passes through no walls
+// Rather than stepping square by square, the line is walked along its shorter axis: each step crosses a contiguous
+// span of squares along the longer axis, which is tested against the packed walls a whole word at a time.
+// A line only touching the corner of a wall is not blocked, matching the diagonal moves allowed by Graph.
+bool WallBitset::hasLineOfSight(const Position &aPosition, const Position &anotherPosition) const {
+	int dx = anotherPosition.xPosition - aPosition.xPosition;
+	int dy = anotherPosition.yPosition - aPosition.yPosition;
+
+	// Walk along x (scanning columns) when the line is steep, otherwise along y (scanning rows)
+	bool walkAlongX = std::abs(dx) <= std::abs(dy);
+	const std::vector<std::uint64_t> &bits = walkAlongX ? columnBits : rowBits;
+	int wordsPerLine = walkAlongX ? wordsPerColumn : wordsPerRow;
+	int minorStart = walkAlongX ? aPosition.xPosition : aPosition.yPosition;
+	int majorStart = walkAlongX ? aPosition.yPosition : aPosition.xPosition;
+	int minorDelta = walkAlongX ? dx : dy;
+	int majorDelta = walkAlongX ? dy : dx;
+	int minorStep = minorDelta < 0 ? -1 : 1;
+	int majorStep = majorDelta < 0 ? -1 : 1;
+	int minorLength = std::abs(minorDelta);
+	int majorLength = std::abs(majorDelta);
+
+	// A purely horizontal or vertical line is a single span
+	if (minorLength == 0) {
+		int majorEnd = majorStart + majorDelta;
+		return !anyWallInSpan(bits, wordsPerLine, minorStart, std::min(majorStart, majorEnd), std::max(majorStart, majorEnd));
+	}
+
+	// All arithmetic is scaled by 2 * minorLength so that square boundaries (half-integers) stay exact integers
+	int scale = 2 * minorLength;
+	for (int k = 0; k <= minorLength; k++) {
+		// Portion of the line within this square along the minor axis, expressed as a major-axis interval
+		int lowNumerator = std::max(2 * k - 1, 0) * majorLength;
+		int highNumerator = std::min(2 * k + 1, scale) * majorLength;
+
+		// Squares along the major axis whose interior is crossed by that interval
+		int firstSquare = std::max(floorDivide(lowNumerator - minorLength, scale) + 1, 0);
+		int lastSquare = std::min(ceilDivide(highNumerator + minorLength, scale) - 1, majorLength);
+
+		int spanStart = majorStart + majorStep * firstSquare;
+		int spanEnd = majorStart + majorStep * lastSquare;
+		if (anyWallInSpan(bits, wordsPerLine, minorStart + minorStep * k, std::min(spanStart, spanEnd), std::max(spanStart, spanEnd))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Method that removes every waypoint of a path that can be skipped by a straight line, returning the reduced path
+// Greedily keeps the farthest waypoint still visible from the last kept waypoint
+std::vector<Position> WallBitset::smoothPath(const std::vector<Position> &aPath) const {
+	// Paths of two or fewer waypoints cannot be reduced
+	if (aPath.size() <= 2) {
+		return aPath;
+	}
+
+	std::vector<Position> smoothedPath;
+	smoothedPath.push_back(aPath.front());
+	for (size_t i = 2; i < aPath.size(); i++) {
+		// Once the next waypoint is hidden from the last kept waypoint, the previous one must be kept
+		if (!hasLineOfSight(smoothedPath.back(), aPath[i])) {
+			smoothedPath.push_back(aPath[i - 1]);
+		}
+	}
+	smoothedPath.push_back(aPath.back());
+	return smoothedPath;
+}
+
+// Accessor method for number of squares horizontally and vertically, returned as an int 2-tuple
+std::tuple<int, int> WallBitset::getNumberOfSquares() const {
+	return std::make_tuple(xTiles, yTiles);
+}
+
+// Helper function that determines whether any wall lies within an inclusive span [first, last] of a single packed line
+bool WallBitset::anyWallInSpan(const std::vector<std::uint64_t> &bits, int wordsPerLine, int line, int first, int last) {
+	const std::uint64_t *lineWords = &bits[static_cast<size_t>(line) * wordsPerLine];
+	int firstWord = first >> 6;
+	int lastWord = last >> 6;
+	std::uint64_t firstMask = ~std::uint64_t(0) << (first & 63);
+	std::uint64_t lastMask = ~std::uint64_t(0) >> (63 - (last & 63));
+
+	// Span lies within a single word
+	if (firstWord == lastWord) {
+		return (lineWords[firstWord] & firstMask & lastMask) != 0;
+	}
+
+	// Partial first word, whole middle words, partial last word
+	if (lineWords[firstWord] & firstMask) {
+		return true;
+	}
+	for (int word = firstWord + 1; word < lastWord; word++) {
+		if (lineWords[word]) {
+			return true;
+		}
+	}
+	return (lineWords[lastWord] & lastMask) != 0;
+}
@@ -0,0 +1,56 @@
+/*
+* Header file for the WallBitset class, a packed bit representation of the walls within a Grid.
+* Provides word-at-a-time line-of-sight checks and path smoothing for any-angle pathfinding.
+*/
+#pragma once
+#include "Position.h"
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+class WallBitset {
+public:
+	// Constructor method for WallBitset object, given number of squares horizontally and vertically
+	WallBitset(std::tuple<int, int>);
+
+	// Method for setting or clearing a wall at given position
+	void setWall(const Position &, bool);
+
+	// Method for setting every position within given vector as a wall
+	void loadWalls(const std::vector<Position> &);
+
+	// Method for clearing all walls
+	void clearWalls();
+
+	// Accessor method for determining whether given position is a wall
+	bool isWall(const Position &) const;
+
+	// Accessor method for determining whether given position lies within the bitset
+	bool inBounds(const Position &) const;
+
+	// Method that determines whether a straight line between the centers of two squares passes through no walls
+	bool hasLineOfSight(const Position &, const Position &) const;
+
+	// Method that removes every waypoint of a path that can be skipped by a straight line, returning the reduced path
+	std::vector<Position> smoothPath(const std::vector<Position> &) const;
+
+	// Accessor method for number of squares horizontally and vertically, returned as an int 2-tuple
+	std::tuple<int, int> getNumberOfSquares() const;
+
+private:
+	// Member variables containing number of horizontal and vertical squares
+	int xTiles;
+	int yTiles;
+
+	// Number of 64-bit words needed to store a single column (indexed by y) and a single row (indexed by x)
+	int wordsPerColumn;
+	int wordsPerRow;
+
+	// Walls packed column by column (bit y of column x) and row by row (bit x of row y)
+	// Both layouts are kept so that any straight line can be scanned along its longer axis
+	std::vector<std::uint64_t> columnBits;
+	std::vector<std::uint64_t> rowBits;
+
+	// Helper function that determines whether any wall lies within an inclusive span of a single packed line
+	static bool anyWallInSpan(const std::vector<std::uint64_t> &, int, int, int, int);
+};
@@ -1,13 +1,85 @@
 /*
 * Driver for pathfinder application.
+* Usage: Pathfinder                                   interactive menu with SFML window
+*        Pathfinder --serve <map file> [socket path]  headless server over standard streams, or a Unix domain socket
+*        Pathfinder --client <socket path>            sends text commands from standard input to a server
 */
 #include <iostream>
+#include <string>
 #include "Grid.h"
 #include "Graph.h"
 #include "AStar.h"
 #include "Dijkstra.h"
+#include "ThetaStar.h"
+#include "WallBitset.h"
+#include "Connection.h"
+#include "PathClient.h"
+#include "PathServer.h"
+
+// Loads a map once and answers queries until shut down
+int runServer(const std::string &mapPath, const std::string &socketPath) {
+	std::tuple<int, int> numSquares;
+	std::vector<Position> walls;
+	if (!PathServer::readMap(mapPath, numSquares, walls)) {
+		std::cerr << "Unable to read map " << mapPath << "\n";
+		return 1;
+	}
+	PathServer server(numSquares);
+	server.loadWalls(walls);
+
+	// Without a socket path, standard streams carry the frames (so diagnostics must go to std::cerr)
+	if (socketPath.empty()) {
+		StreamConnection connection;
+		server.serve(connection);
+		return 0;
+	}
+
+	socketHandle listener = SocketConnection::listenAt(socketPath);
+	if (listener == invalidSocket) {
+		std::cerr << "Unable to listen at " << socketPath << "\n";
+		return 1;
+	}
+	std::cerr << "Serving " << mapPath << " at " << socketPath << "\n";
+
+	// Clients are served one after another, all sharing the resident map
+	bool keepServing = true;
+	while (keepServing) {
+		socketHandle client = SocketConnection::acceptFrom(listener);
+		if (client == invalidSocket) {
+			break;
+		}
+		SocketConnection connection(client);
+		keepServing = server.serve(connection);
+	}
+	SocketConnection::closeSocket(listener);
+	return 0;
+}
+
+// Connects to a server and forwards commands from standard input
+int runClient(const std::string &socketPath) {
+	socketHandle server = SocketConnection::connectTo(socketPath);
+	if (server == invalidSocket) {
+		std::cerr << "Unable to connect to " << socketPath << "\n";
+		return 1;
+	}
+	SocketConnection connection(server);
+
+	// Unsynchronized streams let piped commands be batched into fewer writes
+	std::ios::sync_with_stdio(false);
+	PathClient client(connection);
+	client.run(std::cin, std::cout);
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	// Headless modes never open a window
+	if (argc >= 3 && std::string(argv[1]) == "--serve") {
+		return runServer(argv[2], argc >= 4 ? argv[3] : "");
+	}
+	if (argc >= 3 && std::string(argv[1]) == "--client") {
+		return runClient(argv[2]);
+	}
 
-int main() {
 	// Declare 1024x1024 SFML window at 60 FPS
 	sf::RenderWindow window(sf::VideoMode(900, 900), "PATHFINDER");
 	window.setFramerateLimit(60);
@@ -20,7 +92,7 @@ int main() {
 		char graphChoice;
 		int xCoord = 0, yCoord = 0, index = 0;
 		std::cout << "\t-----PATHFINDER-----\n";
-		std::cout << "Choose pathfinding algorithm ('A' for A*, 'D' for Dijkstra): \n";
+		std::cout << "Choose pathfinding algorithm ('A' for A*, 'D' for Dijkstra, 'T' for Theta*): \n";
 		std::cin >> graphChoice;
 		std::cout << "Choose coordinates of walls, one integer at a time. (-1 to continue): \n";
 		while (xCoord != -1 || yCoord != -1) {
@@ -37,6 +109,9 @@ int main() {
 		Position endPosition = aGrid.getEndPosition();
 		std::vector<Position> walls = aGrid.getWallPositions();
 		aGrid.drawGrid();
+		if (!aGrid.isReachable(startPosition, endPosition)) {
+			std::cout << "End position is walled off from start position, no path exists.\n";
+		}
 		// Instantiate an object of desired algorithm class and display results
 		if (graphChoice == 'D') {
 			std::cout << "Calculating path using Dijkstra's algorithm...\n";
@@ -54,6 +129,15 @@ int main() {
 			aGrid.drawPath();
 			window.display();
 		}
+		if (graphChoice == 'T') {
+			std::cout << "Calculating any-angle path using Theta* algorithm...\n";
+			WallBitset wallBitset(aGrid.getNumberOfSquares());
+			ThetaStar thetaStarAlgorithm(aGraph, wallBitset);
+			thetaStarAlgorithm.findPath(startPosition, endPosition, walls, aGrid, window);
+			thetaStarAlgorithm.loadPath(aGrid);
+			aGrid.drawPath();
+			window.display();
+		}
 	}
 	return 0;
 }
\ No newline at end of file